@@ -0,0 +1,1018 @@
+#include <Table.h>
+#include <TableND.h>
+#include <CompiledTable.h>
+#include <TableSet.h>
+#include <TableGrid.h>
+#include <FixedAxisTable.h>
+#include <ConcurrentTable.h>
+
+/**
+ * Cpp benchmark of Table.h
+ *
+ * Measures the throughput of the library on the native platform. Each benchmark is
+ * run several times and the fastest run is reported, so runs can be compared for
+ * regressions. The output is one CSV row per benchmark:
+ *
+ *   benchmark,ops,ns_per_op,ops_per_s,hit_rate
+ *
+ * hit_rate is the cache hit rate in percent for the benchmarks of a cache, empty otherwise.
+ * Pass a name as the first argument to run only the benchmarks containing it.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+constexpr unsigned int samples = 4096;
+constexpr unsigned int iterations = 100;
+constexpr unsigned int runs = 5;
+
+// benchmark name filter, from the command line.
+static std::string filter;
+// keeps the results live so the lookups are not optimised away.
+static volatile double sink;
+
+bool enabled(const std::string& name){
+    return filter.empty() || name.find(filter) != std::string::npos;
+}
+
+/**
+ * Runs a benchmark body several times.
+ * @return the duration of the fastest run in seconds.
+ */
+template<typename F>
+double measure(F body){
+    double best = 0;
+    for (unsigned int r = 0; r < runs; r++) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (r == 0 || seconds < best) best = seconds;
+    }
+    return best;
+}
+
+void report(const std::string& name, double ops, double seconds, double hitRate = -1){
+    std::cout << name << "," << static_cast<long>(ops) << "," << std::to_string(seconds * 1e9 / ops) << ","
+              << static_cast<long>(ops / seconds) << "," << (hitRate < 0 ? "" : std::to_string(hitRate)) << std::endl;
+}
+
+template<typename TableT, unsigned int xSize, unsigned int ySize>
+void setupMap(TableT& map, bool uniform = false, int axisMax = 6400){
+    map.initialise();
+
+    // Axis data, spread over 0..axisMax, either rounded to uneven steps or with an even step
+    for (unsigned int x = 0; x < xSize; x++) { map.setXAxisValueByIndex(x, uniform ? x * (axisMax / (xSize - 1)) : x * axisMax / (xSize - 1)); }
+    for (unsigned int y = 0; y < ySize; y++) { map.setYAxisValueByIndex(y, uniform ? y * (axisMax / (ySize - 1)) : y * axisMax / (ySize - 1)); }
+
+    // Table data
+    for (unsigned int x = 0; x < xSize; x++) {
+        for (unsigned int y = 0; y < ySize; y++) { map.setValueByIndex(x, y, (x * 31 + y * 17) % 200); }
+    }
+}
+
+/**
+ * Pseudo random inputs within 0..max, so neither the result nor the bracket cache is hit.
+ */
+template<typename XAxisT, typename YAxisT>
+void randomInputs(XAxisT* inputX, YAxisT* inputY, int xMax, int yMax){
+    std::uint32_t seed = 12345;
+    for (unsigned int i = 0; i < samples; i++) {
+        seed = seed * 1664525 + 1013904223;
+        inputX[i] = static_cast<XAxisT>((seed >> 8) % (xMax + 1));
+        seed = seed * 1664525 + 1013904223;
+        inputY[i] = static_cast<YAxisT>((seed >> 8) % (yMax + 1));
+    }
+}
+
+/**
+ * Noisy sensor style inputs, a random walk over 0..6400.
+ */
+void walkInputs(int* inputX, int* inputY){
+    int x = 3200;
+    int y = 3200;
+    std::uint32_t seed = 12345;
+    for (unsigned int i = 0; i < samples; i++) {
+        seed = seed * 1664525 + 1013904223;
+        x += static_cast<int>((seed >> 8) % 81) - 40;
+        seed = seed * 1664525 + 1013904223;
+        y += static_cast<int>((seed >> 8) % 81) - 40;
+        x = x < 0 ? 0 : (x > 6400 ? 6400 : x);
+        y = y < 0 ? 0 : (y > 6400 ? 6400 : y);
+        inputX[i] = x;
+        inputY[i] = y;
+    }
+}
+
+/**
+ * getValue of random interpolated points, cache misses.
+ */
+template<unsigned int xSize, unsigned int ySize, typename T = std::uint16_t, typename XAxisT = int, typename YAxisT = int, typename Layout = TableRowMajor>
+void benchmarkGetValue(const std::string& name, bool uniform = false, int axisMax = 6400){
+    if (!enabled(name)) return;
+    Table<T, xSize, ySize, XAxisT, YAxisT, double, Layout> map;
+    setupMap<decltype(map), xSize, ySize>(map, uniform, axisMax);
+    const int xMax = uniform ? (xSize - 1) * (axisMax / (xSize - 1)) : axisMax;
+    const int yMax = uniform ? (ySize - 1) * (axisMax / (ySize - 1)) : axisMax;
+
+    XAxisT inputX[samples];
+    YAxisT inputY[samples];
+    randomInputs(inputX, inputY, xMax, yMax);
+
+    double seconds = measure([&]() {
+        double sum = 0;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) { sum += map.getValue(inputX[i], inputY[i]); }
+        }
+        sink = sum;
+    });
+    report(name, static_cast<double>(samples) * iterations, seconds);
+}
+
+/**
+ * getValue of the same point, result cache hits, and of breakpoints, no interpolation.
+ */
+template<unsigned int xSize, unsigned int ySize>
+void benchmarkGetValueExact(const std::string& name){
+    if (!enabled(name)) return;
+    Table<std::uint16_t, xSize, ySize> map;
+    setupMap<decltype(map), xSize, ySize>(map);
+
+    double seconds = measure([&]() {
+        double sum = 0;
+        for (unsigned int n = 0; n < iterations * samples; n++) { sum += map.getValue(1234, 2345); }
+        sink = sum;
+    });
+    double lookups = static_cast<double>(samples) * iterations;
+    report(name + " hit", lookups, seconds, 100.0 * map.getResultCacheHits() / (lookups * runs));
+
+    // Breakpoints of random cells
+    int inputX[samples];
+    int inputY[samples];
+    randomInputs(inputX, inputY, xSize - 1, ySize - 1);
+    for (unsigned int i = 0; i < samples; i++) {
+        inputX[i] = inputX[i] * 6400 / (xSize - 1);
+        inputY[i] = inputY[i] * 6400 / (ySize - 1);
+    }
+    seconds = measure([&]() {
+        double sum = 0;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) { sum += map.getValue(inputX[i], inputY[i]); }
+        }
+        sink = sum;
+    });
+    report(name + " breakpoint", lookups, seconds);
+}
+
+/**
+ * The cache-free const getValue.
+ */
+template<unsigned int xSize, unsigned int ySize>
+void benchmarkGetValueConst(const std::string& name){
+    if (!enabled(name)) return;
+    Table<std::uint16_t, xSize, ySize> map;
+    setupMap<decltype(map), xSize, ySize>(map);
+    const Table<std::uint16_t, xSize, ySize>& constMap = map;
+
+    int inputX[samples];
+    int inputY[samples];
+    randomInputs(inputX, inputY, 6400, 6400);
+
+    double seconds = measure([&]() {
+        double sum = 0;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) { sum += constMap.getValue(inputX[i], inputY[i]); }
+        }
+        sink = sum;
+    });
+    report(name, static_cast<double>(samples) * iterations, seconds);
+}
+
+/**
+ * getValue of a random walk, bracket cache hits.
+ */
+template<unsigned int xSize, unsigned int ySize, typename Layout = TableRowMajor>
+void benchmarkGetValueWalk(const std::string& name){
+    if (!enabled(name)) return;
+    Table<std::uint16_t, xSize, ySize, int, int, double, Layout> map;
+    setupMap<decltype(map), xSize, ySize>(map);
+
+    int inputX[samples];
+    int inputY[samples];
+    walkInputs(inputX, inputY);
+
+    double seconds = measure([&]() {
+        double sum = 0;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) { sum += map.getValue(inputX[i], inputY[i]); }
+        }
+        sink = sum;
+    });
+    double hits = map.getBracketCacheHits();
+    double total = hits + map.getBracketCacheMisses();
+    report(name, static_cast<double>(samples) * iterations, seconds, 100.0 * hits / total);
+}
+
+/**
+ * Interleaved consumers of one table, with the table's cache or a lookup context each.
+ */
+template<unsigned int xSize, unsigned int ySize>
+void benchmarkConsumers(const std::string& name, bool contexts){
+    if (!enabled(name)) return;
+    typedef Table<std::uint16_t, xSize, ySize> MapT;
+    MapT map;
+    setupMap<MapT, xSize, ySize>(map);
+    constexpr unsigned int consumers = 3;
+
+    // Each consumer walks its own part of the table and reads it several times per
+    // change of input, as per cylinder trims, a logger and a diagnostics task would
+    int inputX[consumers][samples];
+    int inputY[consumers][samples];
+    std::uint32_t seed = 12345;
+    for (unsigned int c = 0; c < consumers; c++) {
+        int x = 1000 + c * 2000;
+        int y = 1000 + c * 2000;
+        for (unsigned int i = 0; i < samples; i++) {
+            if (i % 4 == 0) {
+                seed = seed * 1664525 + 1013904223;
+                x += static_cast<int>((seed >> 8) % 81) - 40;
+                seed = seed * 1664525 + 1013904223;
+                y += static_cast<int>((seed >> 8) % 81) - 40;
+                x = x < 0 ? 0 : (x > 6400 ? 6400 : x);
+                y = y < 0 ? 0 : (y > 6400 ? 6400 : y);
+            }
+            inputX[c][i] = x;
+            inputY[c][i] = y;
+        }
+    }
+
+    typename MapT::LookupContext context[consumers];
+    double seconds = measure([&]() {
+        double sum = 0;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) {
+                for (unsigned int c = 0; c < consumers; c++) {
+                    sum += contexts ? map.getValue(inputX[c][i], inputY[c][i], context[c]) : map.getValue(inputX[c][i], inputY[c][i]);
+                }
+            }
+        }
+        sink = sum;
+    });
+
+    // Hit rate of the result cache
+    double lookups = static_cast<double>(samples) * iterations * consumers;
+    double hits = 0;
+    if (contexts) {
+        for (unsigned int c = 0; c < consumers; c++) hits += context[c].getResultCacheHits();
+    } else {
+        hits = map.getResultCacheHits();
+    }
+    report(name, lookups, seconds, 100.0 * hits / (lookups * runs));
+}
+
+/**
+ * A multi cylinder trace with the result cache sized to CacheSize.
+ */
+template<unsigned int CacheSize>
+void benchmarkCacheSize(const std::string& name){
+    if (!enabled(name)) return;
+    typedef Table<std::uint16_t, 16, 16, int, int, double, TableRowMajor, CacheSize> MapT;
+    MapT map;
+    setupMap<MapT, 16, 16>(map);
+    constexpr unsigned int cylinders = 6;
+
+    // Multi cylinder trace: each cylinder reads the map in firing order with its own
+    // load, rpm and load are sampled once every 4 engine cycles
+    int inputX[samples];
+    int inputY[samples];
+    int rpm = 3200;
+    int load = 3200;
+    std::uint32_t seed = 12345;
+    for (unsigned int i = 0; i < samples; i++) {
+        if (i % (cylinders * 4) == 0) {
+            seed = seed * 1664525 + 1013904223;
+            rpm += static_cast<int>((seed >> 8) % 81) - 40;
+            seed = seed * 1664525 + 1013904223;
+            load += static_cast<int>((seed >> 8) % 81) - 40;
+            rpm = rpm < 0 ? 0 : (rpm > 6000 ? 6000 : rpm);
+            load = load < 0 ? 0 : (load > 6000 ? 6000 : load);
+        }
+        inputX[i] = rpm;
+        inputY[i] = load + static_cast<int>(i % cylinders) * 60;
+    }
+
+    double seconds = measure([&]() {
+        double sum = 0;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) { sum += map.getValue(inputX[i], inputY[i]); }
+        }
+        sink = sum;
+    });
+    double lookups = static_cast<double>(samples) * iterations;
+    report(name, lookups, seconds, 100.0 * map.getResultCacheHits() / (lookups * runs));
+}
+
+/**
+ * A 3d table as one TableND, and as one Table per breakpoint of the third axis.
+ */
+template<unsigned int xSize, unsigned int ySize, unsigned int zSize>
+void benchmarkTableND(const std::string& name){
+    if (!enabled(name)) return;
+    // RPM x MAP x coolant temperature, as one TableND and as one Table per temperature
+    TableND<std::uint16_t, TableAxis<xSize>, TableAxis<ySize>, TableAxis<zSize>> map;
+    static Table<std::uint16_t, xSize, ySize> planes[zSize];
+    int zAxis[zSize];
+    map.initialise();
+    for (unsigned int z = 0; z < zSize; z++) {
+        zAxis[z] = static_cast<int>(z * 120 / (zSize - 1)) - 20;
+        setupMap<Table<std::uint16_t, xSize, ySize>, xSize, ySize>(planes[z]);
+        map.template setAxisValueByIndex<2>(z, zAxis[z]);
+    }
+    for (unsigned int x = 0; x < xSize; x++) { map.template setAxisValueByIndex<0>(x, x * 6400 / (xSize - 1)); }
+    for (unsigned int y = 0; y < ySize; y++) { map.template setAxisValueByIndex<1>(y, y * 6400 / (ySize - 1)); }
+    for (unsigned int z = 0; z < zSize; z++) {
+        for (unsigned int x = 0; x < xSize; x++) {
+            for (unsigned int y = 0; y < ySize; y++) {
+                const std::uint16_t value = (x * 31 + y * 17 + z * 7) % 1000;
+                planes[z].setValueByIndex(x, y, value);
+                map.setValueByIndex({x, y, z}, value);
+            }
+        }
+    }
+
+    int inputX[samples];
+    int inputY[samples];
+    int inputZ[samples];
+    randomInputs(inputX, inputY, 6400, 6400);
+    std::uint32_t seed = 54321;
+    for (unsigned int i = 0; i < samples; i++) {
+        seed = seed * 1664525 + 1013904223;
+        inputZ[i] = static_cast<int>((seed >> 8) % 121) - 20;
+    }
+
+    // Manual: find the temperature segment, look up both planes and blend
+    double seconds = measure([&]() {
+        double sum = 0;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) {
+                unsigned int z = 0;
+                while (z + 2 < zSize && inputZ[i] > zAxis[z + 1]) z++;
+                const double w = static_cast<double>(inputZ[i] - zAxis[z]) / (zAxis[z + 1] - zAxis[z]);
+                const double lower = planes[z].getValue(inputX[i], inputY[i]);
+                const double upper = planes[z + 1].getValue(inputX[i], inputY[i]);
+                sum += lower + (upper - lower) * w;
+            }
+        }
+        sink = sum;
+    });
+    report(name + " manual", static_cast<double>(samples) * iterations, seconds);
+
+    seconds = measure([&]() {
+        double sum = 0;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) { sum += map.getValue(inputX[i], inputY[i], inputZ[i]); }
+        }
+        sink = sum;
+    });
+    report(name + " TableND", static_cast<double>(samples) * iterations, seconds);
+}
+
+/**
+ * CompiledTable lookups, and the incremental rebuild of setValueByIndex.
+ */
+template<unsigned int xSize, unsigned int ySize>
+void benchmarkCompiled(const std::string& name){
+    if (!enabled(name)) return;
+    static CompiledTable<std::uint16_t, xSize, ySize> map;
+    setupMap<CompiledTable<std::uint16_t, xSize, ySize>, xSize, ySize>(map);
+
+    int inputX[samples];
+    int inputY[samples];
+    randomInputs(inputX, inputY, 6400, 6400);
+    double seconds = measure([&]() {
+        double sum = 0;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) { sum += map.getValue(inputX[i], inputY[i]); }
+        }
+        sink = sum;
+    });
+    report(name + " getValue", static_cast<double>(samples) * iterations, seconds);
+
+    walkInputs(inputX, inputY);
+    seconds = measure([&]() {
+        double sum = 0;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) { sum += map.getValue(inputX[i], inputY[i]); }
+        }
+        sink = sum;
+    });
+    report(name + " getValue walk", static_cast<double>(samples) * iterations, seconds);
+
+    randomInputs(inputX, inputY, xSize - 1, ySize - 1);
+    seconds = measure([&]() {
+        bool ok = true;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) { ok &= map.setValueByIndex(inputX[i], inputY[i], static_cast<std::uint16_t>(i)); }
+        }
+        sink = ok;
+    });
+    report(name + " setValueByIndex", static_cast<double>(samples) * iterations, seconds);
+}
+
+/**
+ * Segment search by Index on uint16_t axes over 0..6400: random inputs through the
+ * const getValue, the binary search, and a random walk through getValue, the search
+ * from the previous segment.
+ */
+template<unsigned int xSize, unsigned int ySize, typename Index>
+void benchmarkIndex(const std::string& name){
+    if (!enabled(name)) return;
+    typedef Table<std::uint16_t, xSize, ySize, std::uint16_t, std::uint16_t, double, TableRowMajor, 1, TableNoStats, Index> IndexTable;
+    static IndexTable map;
+    setupMap<IndexTable, xSize, ySize>(map);
+    map.buildAxisIndexes();
+    const IndexTable& constMap = map;
+
+    std::uint16_t inputX[samples];
+    std::uint16_t inputY[samples];
+    randomInputs(inputX, inputY, 6400, 6400);
+    double seconds = measure([&]() {
+        double sum = 0;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) { sum += constMap.getValue(inputX[i], inputY[i]); }
+        }
+        sink = sum;
+    });
+    report(name + " random", static_cast<double>(samples) * iterations, seconds);
+
+    int walkX[samples];
+    int walkY[samples];
+    walkInputs(walkX, walkY);
+    for (unsigned int i = 0; i < samples; i++) {
+        inputX[i] = static_cast<std::uint16_t>(walkX[i]);
+        inputY[i] = static_cast<std::uint16_t>(walkY[i]);
+    }
+    seconds = measure([&]() {
+        double sum = 0;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) { sum += map.getValue(inputX[i], inputY[i]); }
+        }
+        sink = sum;
+    });
+    report(name + " walk", static_cast<double>(samples) * iterations, seconds);
+}
+
+/**
+ * K maps on the same axes, as K Tables against one TableSet.
+ */
+template<unsigned int K, unsigned int xSize, unsigned int ySize>
+void benchmarkTableSet(const std::string& name){
+    if (!enabled(name)) return;
+    static Table<std::uint16_t, xSize, ySize> tables[K];
+    static TableSet<std::uint16_t, K, xSize, ySize> maps;
+    // The axes of setupMap
+    maps.initialise();
+    for (unsigned int x = 0; x < xSize; x++) { maps.setXAxisValueByIndex(x, x * 6400 / (xSize - 1)); }
+    for (unsigned int y = 0; y < ySize; y++) { maps.setYAxisValueByIndex(y, y * 6400 / (ySize - 1)); }
+    for (unsigned int k = 0; k < K; k++) {
+        setupMap<Table<std::uint16_t, xSize, ySize>, xSize, ySize>(tables[k]);
+        for (unsigned int x = 0; x < xSize; x++) {
+            for (unsigned int y = 0; y < ySize; y++) { maps.setValueByIndex(k, x, y, tables[k].getValueByIndex(x, y)); }
+        }
+    }
+
+    int inputX[samples];
+    int inputY[samples];
+    randomInputs(inputX, inputY, 6400, 6400);
+    double seconds = measure([&]() {
+        double sum = 0;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) {
+                for (unsigned int k = 0; k < K; k++) { sum += tables[k].getValue(inputX[i], inputY[i]); }
+            }
+        }
+        sink = sum;
+    });
+    report(name + " tables", static_cast<double>(samples) * iterations, seconds);
+
+    seconds = measure([&]() {
+        double sum = 0;
+        double out[K];
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) {
+                maps.getValues(inputX[i], inputY[i], out);
+                for (unsigned int k = 0; k < K; k++) { sum += out[k]; }
+            }
+        }
+        sink = sum;
+    });
+    report(name + " set", static_cast<double>(samples) * iterations, seconds);
+}
+
+/**
+ * X for a target value at random Y, a bisection of getValue calls against getXForValue.
+ */
+template<unsigned int xSize, unsigned int ySize>
+void benchmarkInverse(const std::string& name){
+    if (!enabled(name)) return;
+    Table<std::uint16_t, xSize, ySize> map;
+    setupMap<decltype(map), xSize, ySize>(map);
+    // Rising along x at every y
+    for (unsigned int x = 0; x < xSize; x++) {
+        for (unsigned int y = 0; y < ySize; y++) { map.setValueByIndex(x, y, static_cast<std::uint16_t>(x * 40 + y * 7 + (x * y) % 13)); }
+    }
+    const double maxTarget = (xSize - 1) * 40;
+
+    int inputY[samples];
+    double targets[samples];
+    randomInputs(inputY, inputY, 6400, 6400);
+    std::uint32_t seed = 54321;
+    for (unsigned int i = 0; i < samples; i++) {
+        seed = seed * 1664525 + 1013904223;
+        targets[i] = ySize * 7 + 13 + (seed >> 8) % static_cast<unsigned int>(maxTarget - ySize * 7 - 13);
+    }
+
+    double seconds = measure([&]() {
+        double sum = 0;
+        for (unsigned int n = 0; n < iterations / 10; n++) {
+            for (unsigned int i = 0; i < samples; i++) {
+                // Bisection to the integer x either side of the target, then a linear step
+                int lo = 0;
+                int hi = 6400;
+                while (hi - lo > 1) {
+                    const int mid = (lo + hi) / 2;
+                    if (map.getValue(mid, inputY[i]) < targets[i]) lo = mid; else hi = mid;
+                }
+                const double vLo = map.getValue(lo, inputY[i]);
+                const double vHi = map.getValue(hi, inputY[i]);
+                sum += lo + (targets[i] - vLo) / (vHi - vLo);
+            }
+        }
+        sink = sum;
+    });
+    report(name + " bisection", static_cast<double>(samples) * (iterations / 10), seconds);
+
+    seconds = measure([&]() {
+        double sum = 0;
+        double x = 0;
+        for (unsigned int n = 0; n < iterations / 10; n++) {
+            for (unsigned int i = 0; i < samples; i++) {
+                map.getXForValue(targets[i], inputY[i], x);
+                sum += x;
+            }
+        }
+        sink = sum;
+    });
+    report(name + " getXForValue", static_cast<double>(samples) * (iterations / 10), seconds);
+}
+
+/**
+ * Value and gradient of random points, central finite differences against getValueAndGradient.
+ */
+template<unsigned int xSize, unsigned int ySize>
+void benchmarkGradient(const std::string& name){
+    if (!enabled(name)) return;
+    Table<std::uint16_t, xSize, ySize> map;
+    setupMap<decltype(map), xSize, ySize>(map);
+
+    int inputX[samples];
+    int inputY[samples];
+    randomInputs(inputX, inputY, 6398, 6398);
+    double seconds = measure([&]() {
+        double sum = 0;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) {
+                const int x = inputX[i] + 1;
+                const int y = inputY[i] + 1;
+                sum += map.getValue(x, y);
+                sum += (map.getValue(x + 1, y) - map.getValue(x - 1, y)) / 2;
+                sum += (map.getValue(x, y + 1) - map.getValue(x, y - 1)) / 2;
+            }
+        }
+        sink = sum;
+    });
+    report(name + " finite differences", static_cast<double>(samples) * iterations, seconds);
+
+    seconds = measure([&]() {
+        double sum = 0;
+        double dX = 0;
+        double dY = 0;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) {
+                sum += map.getValueAndGradient(inputX[i] + 1, inputY[i] + 1, dX, dY);
+                sum += dX + dY;
+            }
+        }
+        sink = sum;
+    });
+    report(name + " getValueAndGradient", static_cast<double>(samples) * iterations, seconds);
+}
+
+/**
+ * A size x size grid over the whole table, a getValue loop against TableGrid::evaluate
+ * on 1 to 8 threads. ops are grid points.
+ */
+template<unsigned int xSize, unsigned int ySize>
+void benchmarkGrid(const std::string& name, const unsigned int size){
+    if (!enabled(name)) return;
+    Table<std::uint16_t, xSize, ySize> map;
+    setupMap<decltype(map), xSize, ySize>(map);
+
+    std::vector<int> inputX(size);
+    std::vector<int> inputY(size);
+    for (unsigned int i = 0; i < size; i++) { inputX[i] = inputY[i] = static_cast<int>(i * 6400 / (size - 1)); }
+    std::vector<double> grid(size * size);
+    const double points = static_cast<double>(size) * size;
+
+    double seconds = measure([&]() {
+        for (unsigned int i = 0; i < size; i++) {
+            for (unsigned int j = 0; j < size; j++) { grid[i * size + j] = map.getValue(inputX[i], inputY[j]); }
+        }
+        sink = grid[size];
+    });
+    report(name + " getValue loop", points, seconds);
+
+    for (unsigned int threads = 1; threads <= 8; threads *= 2) {
+        seconds = measure([&]() {
+            TableGrid::evaluate(map, inputX.data(), size, inputY.data(), size, grid.data(), threads);
+            sink = grid[size];
+        });
+        report(name + " evaluate " + std::to_string(threads) + " threads", points, seconds);
+    }
+}
+
+/**
+ * ConcurrentTable readers alone, then 1 to 4 reader threads while a writer edits a cell and
+ * publishes in a loop, then the publishes against a reader. ops are lookups, or publishes.
+ */
+template<unsigned int xSize, unsigned int ySize>
+void benchmarkConcurrent(const std::string& name){
+    if (!enabled(name)) return;
+    Table<std::uint16_t, xSize, ySize> map;
+    setupMap<decltype(map), xSize, ySize>(map);
+    ConcurrentTable<std::uint16_t, xSize, ySize> shared(map);
+
+    int inputX[samples];
+    int inputY[samples];
+    randomInputs(inputX, inputY, 6400, 6400);
+    auto readLoop = [&]() {
+        double sum = 0;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) { sum += shared.getValue(inputX[i], inputY[i]); }
+        }
+        return sum;
+    };
+
+    double seconds = measure([&]() { sink = readLoop(); });
+    report(name + " read", static_cast<double>(samples) * iterations, seconds);
+
+    for (unsigned int readers = 1; readers <= 4; readers *= 2) {
+        seconds = measure([&]() {
+            std::atomic<bool> stop{false};
+            std::thread writer([&]() {
+                for (unsigned int i = 0; !stop.load(std::memory_order_relaxed); i++) {
+                    shared.stage().setValueByIndex(i % xSize, i / xSize % ySize, static_cast<std::uint16_t>(i));
+                    shared.publish();
+                }
+            });
+            std::vector<double> sums(readers);
+            std::vector<std::thread> pool;
+            for (unsigned int r = 0; r < readers; r++) { pool.emplace_back([&, r]() { sums[r] = readLoop(); }); }
+            for (auto& t : pool) t.join();
+            stop = true;
+            writer.join();
+            sink = sums[0];
+        });
+        report(name + " read " + std::to_string(readers) + " readers with writer", static_cast<double>(samples) * iterations * readers, seconds);
+    }
+
+    seconds = measure([&]() {
+        std::atomic<bool> stop{false};
+        std::thread reader([&]() {
+            double sum = 0;
+            for (unsigned int i = 0; !stop.load(std::memory_order_relaxed); i = (i + 1) % samples) { sum += shared.getValue(inputX[i], inputY[i]); }
+            sink = sum;
+        });
+        for (unsigned int i = 0; i < samples; i++) {
+            shared.stage().setValueByIndex(i % xSize, i / xSize % ySize, static_cast<std::uint16_t>(i));
+            shared.publish();
+        }
+        stop = true;
+        reader.join();
+    });
+    report(name + " publish with reader", samples, seconds);
+}
+
+/**
+ * The uneven breakpoints of setupMap over 0..6400 as a FixedTableAxis.
+ */
+template<unsigned int size, typename Sequence = std::make_integer_sequence<int, size>>
+struct SpreadAxis;
+
+template<unsigned int size, int... i>
+struct SpreadAxis<size, std::integer_sequence<int, i...>> {
+    typedef FixedTableAxis<int, (i * 6400 / static_cast<int>(size - 1))...> type;
+};
+
+/**
+ * Breakpoints as template parameters against the runtime axes of a Table, the same
+ * axes and values. Random inputs, through the const getValue of both, and a random walk.
+ */
+template<unsigned int xSize, unsigned int ySize>
+void benchmarkFixedAxis(const std::string& name){
+    if (!enabled(name)) return;
+    static Table<std::uint16_t, xSize, ySize> map;
+    static FixedAxisTable<std::uint16_t, typename SpreadAxis<xSize>::type, typename SpreadAxis<ySize>::type> fixed;
+    setupMap<decltype(map), xSize, ySize>(map);
+    for (unsigned int x = 0; x < xSize; x++) {
+        for (unsigned int y = 0; y < ySize; y++) { fixed.setValueByIndex(x, y, map.getValueByIndex(x, y)); }
+    }
+    const Table<std::uint16_t, xSize, ySize>& constMap = map;
+
+    int inputX[samples];
+    int inputY[samples];
+    randomInputs(inputX, inputY, 6400, 6400);
+    double seconds = measure([&]() {
+        double sum = 0;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) { sum += constMap.getValue(inputX[i], inputY[i]); }
+        }
+        sink = sum;
+    });
+    report(name + " table random", static_cast<double>(samples) * iterations, seconds);
+    seconds = measure([&]() {
+        double sum = 0;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) { sum += fixed.getValue(inputX[i], inputY[i]); }
+        }
+        sink = sum;
+    });
+    report(name + " fixed random", static_cast<double>(samples) * iterations, seconds);
+
+    walkInputs(inputX, inputY);
+    seconds = measure([&]() {
+        double sum = 0;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) { sum += map.getValue(inputX[i], inputY[i]); }
+        }
+        sink = sum;
+    });
+    report(name + " table walk", static_cast<double>(samples) * iterations, seconds);
+    seconds = measure([&]() {
+        double sum = 0;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) { sum += fixed.getValue(inputX[i], inputY[i]); }
+        }
+        sink = sum;
+    });
+    report(name + " fixed walk", static_cast<double>(samples) * iterations, seconds);
+}
+
+/**
+ * getValues against a getValue loop over the same inputs.
+ */
+template<unsigned int xSize, unsigned int ySize>
+void benchmarkGetValues(const std::string& name){
+    if (!enabled(name)) return;
+    Table<std::uint16_t, xSize, ySize> map;
+    setupMap<decltype(map), xSize, ySize>(map);
+
+    int inputX[samples];
+    int inputY[samples];
+    double output[samples];
+    randomInputs(inputX, inputY, 6400, 6400);
+
+    // Scalar loop
+    double seconds = measure([&]() {
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) { output[i] = map.getValue(inputX[i], inputY[i]); }
+            sink = output[n % samples];
+        }
+    });
+    report(name + " getValue", static_cast<double>(samples) * iterations, seconds);
+
+    // Batch
+    seconds = measure([&]() {
+        for (unsigned int n = 0; n < iterations; n++) {
+            map.getValues(inputX, inputY, output, samples);
+            sink = output[n % samples];
+        }
+    });
+    report(name + " getValues", static_cast<double>(samples) * iterations, seconds);
+
+    // The same on a random walk
+    walkInputs(inputX, inputY);
+    seconds = measure([&]() {
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) { output[i] = map.getValue(inputX[i], inputY[i]); }
+            sink = output[n % samples];
+        }
+    });
+    report(name + " getValue walk", static_cast<double>(samples) * iterations, seconds);
+    seconds = measure([&]() {
+        for (unsigned int n = 0; n < iterations; n++) {
+            map.getValues(inputX, inputY, output, samples);
+            sink = output[n % samples];
+        }
+    });
+    report(name + " getValues walk", static_cast<double>(samples) * iterations, seconds);
+}
+
+/**
+ * setValue by axis value and setValueByIndex.
+ */
+template<unsigned int xSize, unsigned int ySize>
+void benchmarkSetValue(const std::string& name){
+    if (!enabled(name)) return;
+    Table<std::uint16_t, xSize, ySize> map;
+    setupMap<decltype(map), xSize, ySize>(map);
+
+    // Breakpoints of random cells
+    int inputX[samples];
+    int inputY[samples];
+    randomInputs(inputX, inputY, xSize - 1, ySize - 1);
+    int axisX[samples];
+    int axisY[samples];
+    for (unsigned int i = 0; i < samples; i++) {
+        axisX[i] = inputX[i] * 6400 / (xSize - 1);
+        axisY[i] = inputY[i] * 6400 / (ySize - 1);
+    }
+
+    double seconds = measure([&]() {
+        bool ok = true;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) { ok &= map.setValue(axisX[i], axisY[i], static_cast<std::uint16_t>(i)); }
+        }
+        sink = ok;
+    });
+    report(name + " setValue", static_cast<double>(samples) * iterations, seconds);
+
+    seconds = measure([&]() {
+        bool ok = true;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int i = 0; i < samples; i++) { ok &= map.setValueByIndex(inputX[i], inputY[i], static_cast<std::uint16_t>(i)); }
+        }
+        sink = ok;
+    });
+    report(name + " setValueByIndex", static_cast<double>(samples) * iterations, seconds);
+
+    // A whole calibration, element by element against the bulk setters
+    static std::uint16_t plane[xSize * ySize];
+    int xAxis[xSize];
+    int yAxis[ySize];
+    for (unsigned int i = 0; i < xSize * ySize; i++) { plane[i] = static_cast<std::uint16_t>(i % 200); }
+    for (unsigned int x = 0; x < xSize; x++) { xAxis[x] = x * 6400 / (xSize - 1); }
+    for (unsigned int y = 0; y < ySize; y++) { yAxis[y] = y * 6400 / (ySize - 1); }
+    seconds = measure([&]() {
+        bool ok = true;
+        for (unsigned int n = 0; n < iterations; n++) {
+            for (unsigned int x = 0; x < xSize; x++) { ok &= map.setXAxisValueByIndex(x, xAxis[x]); }
+            for (unsigned int y = 0; y < ySize; y++) { ok &= map.setYAxisValueByIndex(y, yAxis[y]); }
+            for (unsigned int x = 0; x < xSize; x++) {
+                for (unsigned int y = 0; y < ySize; y++) { ok &= map.setValueByIndex(x, y, plane[x * ySize + y]); }
+            }
+        }
+        sink = ok;
+    });
+    report(name + " calibration by index", iterations, seconds);
+
+    seconds = measure([&]() {
+        bool ok = true;
+        for (unsigned int n = 0; n < iterations; n++) {
+            ok &= map.setXAxis(xAxis, xSize);
+            ok &= map.setYAxis(yAxis, ySize);
+            ok &= map.setPlane(plane, xSize * ySize);
+        }
+        sink = ok;
+    });
+    report(name + " calibration bulk", iterations, seconds);
+}
+
+/**
+ * saveData and loadData of whole images.
+ */
+template<unsigned int xSize, unsigned int ySize>
+void benchmarkImage(const std::string& name){
+    if (!enabled(name)) return;
+    Table<std::uint16_t, xSize, ySize> map;
+    setupMap<decltype(map), xSize, ySize>(map);
+
+    static char image[decltype(map)::getSize()];
+    double seconds = measure([&]() {
+        bool ok = true;
+        for (unsigned int n = 0; n < iterations; n++) { ok &= map.saveData(image, sizeof(image)); }
+        sink = ok;
+    });
+    report(name + " saveData", iterations, seconds);
+
+    seconds = measure([&]() {
+        bool ok = true;
+        for (unsigned int n = 0; n < iterations; n++) { ok &= map.loadData(image, sizeof(image)); }
+        sink = ok;
+    });
+    report(name + " loadData", iterations, seconds);
+}
+
+void benchmarkCrc32(const std::string& name){
+    if (!enabled(name)) return;
+    static unsigned char data[samples];
+    for (unsigned int i = 0; i < samples; i++) { data[i] = static_cast<unsigned char>(i * 31); }
+
+    double seconds = measure([&]() {
+        std::uint32_t crc = 0;
+        for (unsigned int n = 0; n < iterations; n++) { crc = TableImageFormat::crc32(data, samples, crc); }
+        sink = crc;
+    });
+    report(name, static_cast<double>(iterations) * samples, seconds);
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1) filter = argv[1];
+    std::cout << "benchmark,ops,ns_per_op,ops_per_s,hit_rate" << std::endl;
+
+    benchmarkGetValue<4, 4>("getValue 4x4");
+    benchmarkGetValue<16, 16>("getValue 16x16");
+    benchmarkGetValue<64, 64>("getValue 64x64");
+
+    benchmarkGetValue<4, 4>("getValue uniform 4x4", true);
+    benchmarkGetValue<16, 16>("getValue uniform 16x16", true);
+    benchmarkGetValue<64, 64>("getValue uniform 64x64", true);
+
+    benchmarkGetValue<16, 16, std::uint8_t, std::uint8_t, std::uint8_t>("getValue uint8 uint8 axes 16x16", false, 255);
+    benchmarkGetValue<16, 16, float, std::int16_t, std::int16_t>("getValue float int16 axes 16x16");
+    benchmarkGetValue<16, 16, std::int32_t, long, long>("getValue int32 long axes 16x16");
+
+    benchmarkGetValueExact<16, 16>("getValue exact 16x16");
+    benchmarkGetValueConst<16, 16>("getValue const 16x16");
+
+    benchmarkGetValueWalk<4, 4>("getValue walk 4x4");
+    benchmarkGetValueWalk<16, 16>("getValue walk 16x16");
+    benchmarkGetValueWalk<64, 64>("getValue walk 64x64");
+
+    benchmarkGetValue<64, 64, std::uint16_t, int, int, TableRowMajor>("layout row major 64x64");
+    benchmarkGetValue<64, 64, std::uint16_t, int, int, TableColumnMajor>("layout column major 64x64");
+    benchmarkGetValue<64, 64, std::uint16_t, int, int, TableTiled<4>>("layout tiled 64x64");
+    benchmarkGetValue<512, 512, std::uint16_t, int, int, TableRowMajor>("layout row major 512x512");
+    benchmarkGetValue<512, 512, std::uint16_t, int, int, TableColumnMajor>("layout column major 512x512");
+    benchmarkGetValue<512, 512, std::uint16_t, int, int, TableTiled<4>>("layout tiled 512x512");
+    benchmarkGetValueWalk<512, 512, TableRowMajor>("layout walk row major 512x512");
+    benchmarkGetValueWalk<512, 512, TableColumnMajor>("layout walk column major 512x512");
+    benchmarkGetValueWalk<512, 512, TableTiled<4>>("layout walk tiled 512x512");
+
+    benchmarkConsumers<16, 16>("3 consumers shared cache 16x16", false);
+    benchmarkConsumers<16, 16>("3 consumers lookup contexts 16x16", true);
+
+    benchmarkCacheSize<0>("6 cylinders cache size 0");
+    benchmarkCacheSize<1>("6 cylinders cache size 1");
+    benchmarkCacheSize<4>("6 cylinders cache size 4");
+    benchmarkCacheSize<8>("6 cylinders cache size 8");
+
+    benchmarkTableND<16, 16, 8>("3d 16x16x8");
+    benchmarkTableND<32, 32, 16>("3d 32x32x16");
+
+    benchmarkCompiled<16, 16>("compiled 16x16");
+    benchmarkCompiled<64, 64>("compiled 64x64");
+
+    benchmarkIndex<16, 16, TableSearchIndex>("index search 16x16");
+    benchmarkIndex<16, 16, TableIndexLut<6>>("index lut 6 bits 16x16");
+    benchmarkIndex<16, 16, TableIndexLut<8>>("index lut 8 bits 16x16");
+    benchmarkIndex<16, 16, TableIndexLut<13>>("index lut 13 bits 16x16");
+    benchmarkIndex<64, 64, TableSearchIndex>("index search 64x64");
+    benchmarkIndex<64, 64, TableIndexLut<8>>("index lut 8 bits 64x64");
+    benchmarkIndex<64, 64, TableIndexLut<13>>("index lut 13 bits 64x64");
+
+    benchmarkTableSet<4, 16, 16>("4 maps 16x16");
+    benchmarkTableSet<4, 64, 64>("4 maps 64x64");
+
+    benchmarkInverse<16, 16>("inverse 16x16");
+    benchmarkInverse<64, 64>("inverse 64x64");
+
+    benchmarkGradient<16, 16>("gradient 16x16");
+    benchmarkGradient<64, 64>("gradient 64x64");
+
+    benchmarkGrid<16, 16>("grid 1024x1024 from 16x16", 1024);
+
+    benchmarkFixedAxis<8, 8>("fixed axis 8x8");
+    benchmarkFixedAxis<16, 16>("fixed axis 16x16");
+    benchmarkFixedAxis<32, 32>("fixed axis 32x32");
+
+    benchmarkGetValues<4, 4>("batch 4x4");
+    benchmarkGetValues<16, 16>("batch 16x16");
+    benchmarkGetValues<64, 64>("batch 64x64");
+
+    benchmarkSetValue<16, 16>("set 16x16");
+    benchmarkSetValue<64, 64>("set 64x64");
+
+    benchmarkConcurrent<16, 16>("concurrent 16x16");
+
+    benchmarkImage<16, 16>("image 16x16");
+    benchmarkImage<64, 64>("image 64x64");
+    benchmarkCrc32("crc32 per byte");
+
+    return 0;
+}
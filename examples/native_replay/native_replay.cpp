@@ -0,0 +1,153 @@
+#include <Table.h>
+#include <TableReplay.h>
+
+/**
+ * Datalog replay of Table.h
+ *
+ * Replays a log of (rpm, map, fuel, ignition) samples through candidate fuel and
+ * ignition tables, and reports the error of each against the logged column and the
+ * samples per second. The log is a packed binary file of 4 floats per sample, or a
+ * CSV file of the same columns. The table values of each batch are written to the
+ * output file when given, as packed doubles (fuel, ignition) per sample.
+ *
+ *   program [log.bin | log.csv] [outputs.bin]
+ *
+ * Without a log, a synthetic log is written as replay.bin and replay.csv and both are replayed.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+enum Column { RPM, MAP, FUEL, IGNITION, COLUMNS };
+
+constexpr unsigned int xSize = 16;
+constexpr unsigned int ySize = 16;
+constexpr unsigned int batchSize = 4096;
+constexpr unsigned long syntheticSamples = 2000000;
+
+typedef Table<float, xSize, ySize> MapTable;
+typedef TableLogBatch<COLUMNS, batchSize> Batch;
+
+// Candidate tables, a real retune would loadData its table images
+static MapTable fuelMap;
+static MapTable ignitionMap;
+static Batch batch;
+
+void setupMaps(){
+    fuelMap.initialise();
+    ignitionMap.initialise();
+    for (unsigned int x = 0; x < xSize; x++) {
+        fuelMap.setXAxisValueByIndex(x, 500 + x * 500);
+        ignitionMap.setXAxisValueByIndex(x, 500 + x * 500);
+    }
+    for (unsigned int y = 0; y < ySize; y++) {
+        fuelMap.setYAxisValueByIndex(y, 20 + y * 6);
+        ignitionMap.setYAxisValueByIndex(y, 20 + y * 6);
+    }
+    for (unsigned int x = 0; x < xSize; x++) {
+        for (unsigned int y = 0; y < ySize; y++) {
+            fuelMap.setValueByIndex(x, y, 2.0f + y * 0.6f + x * 0.1f);
+            ignitionMap.setValueByIndex(x, y, 10.0f + x * 1.5f - y * 0.5f);
+        }
+    }
+}
+
+/**
+ * Writes a synthetic log, the logged values are the tables with some noise.
+ */
+void writeSyntheticLog(const char* binaryPath, const char* csvPath){
+    std::FILE* binary = std::fopen(binaryPath, "wb");
+    std::FILE* csv = std::fopen(csvPath, "wb");
+    std::fprintf(csv, "rpm,map,fuel,ignition\n");
+    std::uint32_t seed = 12345;
+    float rpm = 3000;
+    float map = 60;
+    for (unsigned long i = 0; i < syntheticSamples; i++) {
+        seed = seed * 1664525 + 1013904223;
+        rpm += static_cast<float>((seed >> 8) % 201) - 100;
+        map += static_cast<float>((seed >> 16) % 5) - 2;
+        rpm = rpm < 400 ? 400 : (rpm > 8100 ? 8100 : rpm);
+        map = map < 18 ? 18 : (map > 112 ? 112 : map);
+        const float noise = static_cast<float>((seed >> 4) % 100) / 1000.0f - 0.05f;
+        const float sample[COLUMNS] = {rpm, map, static_cast<float>(fuelMap.getValue(rpm, map)) + noise, static_cast<float>(ignitionMap.getValue(rpm, map)) - noise};
+        std::fwrite(sample, sizeof(sample), 1, binary);
+        std::fprintf(csv, "%.0f,%.0f,%.3f,%.3f\n", sample[RPM], sample[MAP], sample[FUEL], sample[IGNITION]);
+    }
+    std::fclose(binary);
+    std::fclose(csv);
+}
+
+void printStats(const std::string& name, const TableReplayStats& stats){
+    std::cout << "  " << name << ": compared " << stats.compared << ", out of bounds " << stats.outOfBounds
+              << ", mean error " << stats.meanError << ", mean abs error " << stats.meanAbsError
+              << ", rms error " << stats.rmsError << ", max abs error " << stats.maxAbsError << std::endl;
+}
+
+/**
+ * Replays a log.
+ * @return false if the log cannot be opened.
+ */
+template<typename Log>
+bool replay(Log& log, const char* path, const char* outputPath){
+    if (!log.open(path)) {
+        std::cerr << "Cannot open " << path << std::endl;
+        return false;
+    }
+    std::FILE* output = outputPath != nullptr ? std::fopen(outputPath, "wb") : nullptr;
+    static double outputs[batchSize][2];
+
+    TableReplayChannel<MapTable> fuel(fuelMap, RPM, MAP, FUEL, batchSize);
+    TableReplayChannel<MapTable> ignition(ignitionMap, RPM, MAP, IGNITION, batchSize);
+    unsigned long samples = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (log.read(batch) > 0) {
+        const double* fuelOut = fuel.process(batch);
+        const double* ignitionOut = ignition.process(batch);
+        if (output != nullptr) {
+            for (unsigned int i = 0; i < batch.count; i++) {
+                outputs[i][0] = fuelOut[i];
+                outputs[i][1] = ignitionOut[i];
+            }
+            std::fwrite(outputs, sizeof(outputs[0]), batch.count, output);
+        }
+        samples += batch.count;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (output != nullptr) std::fclose(output);
+
+    std::cout << path << ": " << samples << " samples in " << seconds << " s, "
+              << static_cast<long>(samples / seconds) << " samples/s" << std::endl;
+    printStats("fuel", fuel.getStats());
+    printStats("ignition", ignition.getStats());
+    return true;
+}
+
+bool endsWith(const std::string& text, const std::string& suffix){
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+int main(int argc, char **argv) {
+    setupMaps();
+    const char* outputPath = argc > 2 ? argv[2] : nullptr;
+
+    if (argc > 1) {
+        if (endsWith(argv[1], ".csv")) {
+            TableCsvLog<COLUMNS> log;
+            return replay(log, argv[1], outputPath) ? 0 : 1;
+        }
+        TableBinaryLog<COLUMNS> log;
+        return replay(log, argv[1], outputPath) ? 0 : 1;
+    }
+
+    std::cout << "Writing a synthetic log of " << syntheticSamples << " samples" << std::endl;
+    writeSyntheticLog("replay.bin", "replay.csv");
+    TableBinaryLog<COLUMNS> binaryLog;
+    TableCsvLog<COLUMNS> csvLog;
+    if (!replay(binaryLog, "replay.bin", nullptr) || !replay(csvLog, "replay.csv", nullptr)) {
+        return 1;
+    }
+    return 0;
+}
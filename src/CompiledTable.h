@@ -0,0 +1,363 @@
+#ifndef EPICECU_COMPILED_TABLE_H
+#define EPICECU_COMPILED_TABLE_H
+
+/**
+ * Compiled Table.
+ *
+ * A Table which keeps the bilinear coefficients of every cell, so a lookup is a
+ * segment search and one evaluation of
+ *
+ *   f(u, v) = a + b * u + c * v + d * u * v
+ *
+ * where u and v are the offsets of the input from the lower breakpoints of its
+ * cell. There is no division on the lookup path. The coefficients of the cells
+ * around a changed value or breakpoint are rebuilt by the setters.
+ *
+ * Each value is the lower corner of a cell, the cells of the last breakpoints
+ * have no width along that axis. Inputs on a breakpoint use the cell of that
+ * breakpoint, so the values there are returned exactly.
+ * Uses 4 ComputeT per value on top of the table, e.g. 8192 bytes for a 16x16
+ * table computed in double. For tables which are retuned rarely and read often.
+ *
+ * Copyright © 2022 David Cedar. All rights reserved.
+ * Licensed under the LGPL License (see LICENSE file)
+ */
+
+#include "Table.h"
+
+template<typename T, unsigned int xSize, unsigned int ySize, typename XAxisT, typename YAxisT, typename ComputeT>
+class CompiledTable : private Table<T, xSize, ySize, XAxisT, YAxisT, ComputeT> {
+    typedef Table<T, xSize, ySize, XAxisT, YAxisT, ComputeT> Base;
+
+public:
+    using Base::getValueByIndex;
+    using Base::saveData;
+    using Base::isXAxisUniform;
+    using Base::isYAxisUniform;
+    using Base::getSize;
+
+    /**
+     * Initialises the Table object.
+     */
+    void initialise() {
+        Base::initialise();
+        lastXIdx = 0;
+        lastYIdx = 0;
+        compile();
+    }
+
+    /**
+     * Gets the value table value by x,y axis value/s.
+     * Starts the search of each axis at the previous cell.
+     * @param X_in The x-axis value.
+     * @param Y_in The y-axis value.
+     * @returns The table value. -1 if out of bounds.
+     */
+    ComputeT getValue(const XAxisT X_in, const YAxisT Y_in) {
+        // Check if requesting over bounds
+        if(X_in > this->axisX[xSize-1] || Y_in > this->axisY[ySize-1] || X_in < this->axisX[0] || Y_in < this->axisY[0]){
+           return -1;
+        }
+        Base::findSegmentFast(this->axisX, xSize, this->xSpacing, X_in, lastXIdx);
+        Base::findSegmentFast(this->axisY, ySize, this->ySpacing, Y_in, lastYIdx);
+        return evaluate(X_in, Y_in, lastXIdx, lastYIdx);
+    }
+
+    /**
+     * Retrieves the value of a specific position.
+     * @param X_in The x-axis value.
+     * @returns The table value. -1 if out of bounds.
+     */
+    ComputeT getValue(const XAxisT X_in) {
+        return getValue(X_in, 1);
+    }
+
+    /**
+     * Gets the value table value by x,y axis value/s, without the cache.
+     * @param X_in The x-axis value.
+     * @param Y_in The y-axis value.
+     * @returns The table value. -1 if out of bounds.
+     */
+    ComputeT getValue(const XAxisT X_in, const YAxisT Y_in) const {
+        // Check if requesting over bounds
+        if(X_in > this->axisX[xSize-1] || Y_in > this->axisY[ySize-1] || X_in < this->axisX[0] || Y_in < this->axisY[0]){
+           return -1;
+        }
+        return evaluate(X_in, Y_in, Base::findSegment(this->axisX, xSize, this->xSpacing, X_in), Base::findSegment(this->axisY, ySize, this->ySpacing, Y_in));
+    }
+
+    /**
+     * Retrieves the value of a specific position, without the cache.
+     * @param X_in The x-axis value.
+     * @returns The table value. -1 if out of bounds.
+     */
+    ComputeT getValue(const XAxisT X_in) const {
+        return getValue(X_in, 1);
+    }
+
+    /**
+     * Sets the value of a specific position in the table.
+     * @param X_in The x-axis value.
+     * @param Y_in The y-axis value.
+     * @param value The new value to set at the specified (x,y) position.
+     * @returns True if the value was set successfully, False otherwise.
+     */
+    bool setValue(const XAxisT X_in, const YAxisT Y_in, const T value) {
+        int x = Base::findIndex(this->axisX, xSize, X_in);
+        int y = Base::findIndex(this->axisY, ySize, Y_in);
+        if (x >= 0 && y >= 0){
+            return setValueByIndex(x, y, value);
+        }
+        return false;
+    }
+
+    /**
+     * Sets the value of a specific position in the table using only the x-axis value.
+     * @param X_in The x-axis value.
+     * @param value The new value to set at the specified (x,y) position.
+     * @returns True if the value was set successfully, False otherwise.
+     */
+    bool setValue(const XAxisT X_in, const T value) {
+        int x = Base::findIndex(this->axisX, xSize, X_in);
+        if (x >= 0){
+            return setValueByIndex(x, value);
+        }
+        return false;
+    }
+
+    /**
+     * Set Value by X and Y Index.
+     * Rebuilds the up to four cells with the value as a corner.
+     * @param x index of the row in the table.
+     * @param y index of the column in the table.
+     * @param value to set.
+     * @returns True if the value was set successfully, False otherwise.
+     */
+    bool setValueByIndex(const unsigned int x, const unsigned int y, const T value) {
+        if (!Base::setValueByIndex(x, y, value)) {
+            return false;
+        }
+        compileCells(x > 0 ? x - 1 : 0, x + 1, y > 0 ? y - 1 : 0, y + 1);
+        return true;
+    }
+
+    /**
+     * Set Value by X Index.
+     * @param x index of the row in the table.
+     * @param value to set.
+     * @returns True if the value was set successfully, False otherwise.
+     */
+    bool setValueByIndex(const unsigned int x, const T value) {
+        return setValueByIndex(x, 0, value);
+    }
+
+    /**
+     * Set X Axis Value by Index.
+     * Rebuilds the cells on both sides of the breakpoint.
+     * @param x index of the row in the table.
+     * @param value to set.
+     * @returns True if the value was set successfully, False otherwise.
+     */
+    bool setXAxisValueByIndex(const unsigned int x, const XAxisT value) {
+        if (!Base::setXAxisValueByIndex(x, value)) {
+            return false;
+        }
+        compileCells(x > 0 ? x - 1 : 0, x + 1, 0, ySize);
+        return true;
+    }
+
+    /**
+     * Set Y Axis Value by Index.
+     * Rebuilds the cells on both sides of the breakpoint.
+     * @param y index of the column in the table.
+     * @param value to set.
+     * @returns True if the value was set successfully, False otherwise.
+     */
+    bool setYAxisValueByIndex(const unsigned int y, const YAxisT value) {
+        if (!Base::setYAxisValueByIndex(y, value)) {
+            return false;
+        }
+        compileCells(0, xSize, y > 0 ? y - 1 : 0, y + 1);
+        return true;
+    }
+
+    /**
+     * Set X Axis, see Table::setXAxis.
+     * Rebuilds every cell.
+     * @param axis the x-axis values, sorted strictly ascending.
+     * @param count number of values, xSize.
+     * @returns True if the axis was set, False if the count is wrong or the values are not ascending.
+     */
+    bool setXAxis(const XAxisT* axis, const unsigned int count) {
+        if (!Base::setXAxis(axis, count)) {
+            return false;
+        }
+        compile();
+        return true;
+    }
+
+    /**
+     * Set Y Axis, see Table::setYAxis.
+     * Rebuilds every cell.
+     * @param axis the y-axis values, sorted strictly ascending.
+     * @param count number of values, ySize.
+     * @returns True if the axis was set, False if the count is wrong or the values are not ascending.
+     */
+    bool setYAxis(const YAxisT* axis, const unsigned int count) {
+        if (!Base::setYAxis(axis, count)) {
+            return false;
+        }
+        compile();
+        return true;
+    }
+
+    /**
+     * Set Row, see Table::setRow.
+     * Rebuilds the cells on both sides of the row.
+     * @param x index of the row in the table.
+     * @param row the values of the row, one per y index.
+     * @param count number of values, ySize.
+     * @returns True if the row was set successfully, False otherwise.
+     */
+    bool setRow(const unsigned int x, const T* row, const unsigned int count) {
+        if (!Base::setRow(x, row, count)) {
+            return false;
+        }
+        compileCells(x > 0 ? x - 1 : 0, x + 1, 0, ySize);
+        return true;
+    }
+
+    /**
+     * Set Column, see Table::setColumn.
+     * Rebuilds the cells on both sides of the column.
+     * @param y index of the column in the table.
+     * @param column the values of the column, one per x index.
+     * @param count number of values, xSize.
+     * @returns True if the column was set successfully, False otherwise.
+     */
+    bool setColumn(const unsigned int y, const T* column, const unsigned int count) {
+        if (!Base::setColumn(y, column, count)) {
+            return false;
+        }
+        compileCells(0, xSize, y > 0 ? y - 1 : 0, y + 1);
+        return true;
+    }
+
+    /**
+     * Set Plane, see Table::setPlane.
+     * Rebuilds every cell.
+     * @param data the table values, the y values of each x index in turn.
+     * @param count number of values, xSize * ySize.
+     * @returns True if the values were set successfully, False otherwise.
+     */
+    bool setPlane(const T* data, const unsigned int count) {
+        if (!Base::setPlane(data, count)) {
+            return false;
+        }
+        compile();
+        return true;
+    }
+
+    /**
+     * Fill, see Table::fill.
+     * Rebuilds every cell.
+     * @param value to set.
+     */
+    void fill(const T value) {
+        Base::fill(value);
+        compile();
+    }
+
+    /**
+     * Load table data from a buffer, see Table::loadData.
+     * Rebuilds every cell.
+     * @param buffer pointer to the data buffer.
+     * @param size size of the buffer in bytes.
+     * @returns true if data was loaded successfully.
+     */
+    bool loadData(const char* buffer, unsigned int size) {
+        if (!Base::loadData(buffer, size)) {
+            return false;
+        }
+        compile();
+        return true;
+    }
+
+    /**
+     * Reset the data to zero.
+     */
+    void resetData() {
+        Base::resetData();
+        compile();
+    }
+
+    /**
+     * Rebuilds the coefficients of every cell.
+     */
+    void compile() {
+        compileCells(0, xSize, 0, ySize);
+    }
+
+private:
+    // bilinear coefficients of a cell.
+    struct Cell {
+        ComputeT a = 0;
+        ComputeT b = 0;
+        ComputeT c = 0;
+        ComputeT d = 0;
+    };
+
+    Cell cells[xSize * ySize];
+    // bracket caching.
+    unsigned int lastXIdx = 0;
+    unsigned int lastYIdx = 0;
+
+    /**
+     * Evaluates the cell containing the input.
+     * @param X_in The x-axis value.
+     * @param Y_in The y-axis value.
+     * @param xSegment the x-axis segment containing X_in.
+     * @param ySegment the y-axis segment containing Y_in.
+     * @returns The table value.
+     */
+    ComputeT evaluate(const XAxisT X_in, const YAxisT Y_in, const unsigned int xSegment, const unsigned int ySegment) const {
+        // An input on the upper breakpoint of its segment uses the cell of that breakpoint
+        const unsigned int xIdx = xSegment + (xSize > 1 && X_in == this->axisX[xSegment + 1]);
+        const unsigned int yIdx = ySegment + (ySize > 1 && Y_in == this->axisY[ySegment + 1]);
+        const Cell& cell = cells[xIdx * ySize + yIdx];
+        const ComputeT u = static_cast<ComputeT>(X_in - this->axisX[xIdx]);
+        const ComputeT v = static_cast<ComputeT>(Y_in - this->axisY[yIdx]);
+        return cell.a + u * (cell.b + cell.d * v) + cell.c * v;
+    }
+
+    /**
+     * Rebuilds the coefficients of the cells whose lower corners are within [x0, x1) x [y0, y1).
+     * The span reciprocals of each segment are computed once for the range.
+     */
+    void compileCells(const unsigned int x0, const unsigned int x1, const unsigned int y0, const unsigned int y1) {
+        const unsigned int xEnd = x1 < xSize ? x1 : xSize;
+        const unsigned int yEnd = y1 < ySize ? y1 : ySize;
+        ComputeT yReciprocal[ySize];
+        for (unsigned int y = y0; y < yEnd; y++) {
+            yReciprocal[y] = y + 1 < ySize && this->axisY[y + 1] != this->axisY[y] ? static_cast<ComputeT>(1) / static_cast<ComputeT>(this->axisY[y + 1] - this->axisY[y]) : 0;
+        }
+        for (unsigned int x = x0; x < xEnd; x++) {
+            const unsigned int xUpper = x + 1 < xSize ? x + 1 : x;
+            const ComputeT xReciprocal = x + 1 < xSize && this->axisX[x + 1] != this->axisX[x] ? static_cast<ComputeT>(1) / static_cast<ComputeT>(this->axisX[x + 1] - this->axisX[x]) : 0;
+            for (unsigned int y = y0; y < yEnd; y++) {
+                const unsigned int yUpper = y + 1 < ySize ? y + 1 : y;
+                const ComputeT q11 = getValueByIndex(x, y);
+                const ComputeT q12 = getValueByIndex(x, yUpper);
+                const ComputeT q21 = getValueByIndex(xUpper, y);
+                const ComputeT q22 = getValueByIndex(xUpper, yUpper);
+                Cell& cell = cells[x * ySize + y];
+                cell.a = q11;
+                cell.b = (q21 - q11) * xReciprocal;
+                cell.c = (q12 - q11) * yReciprocal[y];
+                cell.d = (q22 - q21 - q12 + q11) * xReciprocal * yReciprocal[y];
+            }
+        }
+    }
+};
+
+#endif // EPICECU_COMPILED_TABLE_H
@@ -0,0 +1,160 @@
+#ifndef EPICECU_CONCURRENT_TABLE_H
+#define EPICECU_CONCURRENT_TABLE_H
+
+/**
+ * Concurrent Table.
+ *
+ * A Table which is read by several threads, cores or interrupts while a tuning task
+ * updates it. Uses the Left-Right technique: two copies of the table, readers use
+ * the copy the writer is not changing. Readers are wait-free, they never block and
+ * never retry. A writer stages any number of cell and axis edits and publishes them
+ * at once, readers see either all of them or none.
+ *
+ * Requires <atomic> and <mutex>, for native and RTOS targets.
+ *
+ * Copyright © 2022 David Cedar. All rights reserved.
+ * Licensed under the LGPL License (see LICENSE file)
+ */
+
+#include "Table.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+template<typename T, unsigned int xSize, unsigned int ySize = 1, typename XAxisT = int, typename YAxisT = int, typename ComputeT = double, typename Layout = TableRowMajor, unsigned int CacheSize = 1>
+class ConcurrentTable {
+public:
+    typedef Table<T, xSize, ySize, XAxisT, YAxisT, ComputeT, Layout, CacheSize> TableType;
+
+    /**
+     * Constructs an empty table.
+     */
+    ConcurrentTable() {
+        staging.initialise();
+        instances[0] = staging;
+        instances[1] = staging;
+    }
+
+    /**
+     * Constructs a table holding a copy of another.
+     * @param table the initial table.
+     */
+    explicit ConcurrentTable(const TableType& table) : staging(table) {
+        instances[0] = staging;
+        instances[1] = staging;
+    }
+
+    /**
+     * Gets the value table value by x,y axis value/s. Wait-free.
+     * @param X_in The x-axis value.
+     * @param Y_in The y-axis value.
+     * @returns The table value. -1 if out of bounds.
+     */
+    ComputeT getValue(const XAxisT X_in, const YAxisT Y_in) const {
+        return read([&](const TableType& table) { return table.getValue(X_in, Y_in); });
+    }
+
+    /**
+     * Retrieves the value of a specific position. Wait-free.
+     * @param X_in The x-axis value.
+     * @returns The table value. -1 if out of bounds.
+     */
+    ComputeT getValue(const XAxisT X_in) const {
+        return getValue(X_in, 1);
+    }
+
+    /**
+     * Gets a batch of table values, all from the same published table. Wait-free.
+     * @param X_in array of x-axis values.
+     * @param Y_in array of y-axis values.
+     * @param out array receiving the table values. -1 where out of bounds.
+     * @param count number of values.
+     */
+    void getValues(const XAxisT* X_in, const YAxisT* Y_in, ComputeT* out, const unsigned int count) const {
+        read([&](const TableType& table) { table.getValues(X_in, Y_in, out, count); });
+    }
+
+    /**
+     * Runs a function on the published table. Wait-free.
+     * The function must not keep the reference, the copy it refers to is reused by the writer.
+     * @param f function taking a const TableType reference.
+     * @returns the result of the function.
+     */
+    template<typename F>
+    auto read(F f) const -> decltype(f(std::declval<const TableType&>())) {
+        const unsigned int version = versionIndex.load(std::memory_order_seq_cst);
+        ReaderGuard guard(readers[version]);
+        return f(instances[leftRight.load(std::memory_order_seq_cst)]);
+    }
+
+    /**
+     * Stage.
+     * The writer's copy of the table. Edits made through it are seen by readers after publish().
+     * Only one thread may edit and publish at a time.
+     * @return the staged table.
+     */
+    TableType& stage() {
+        return staging;
+    }
+
+    /**
+     * Publishes the staged table to the readers, all staged edits at once.
+     * Waits for readers of the previous table to finish, readers are never blocked.
+     */
+    void publish() {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        const unsigned int current = leftRight.load(std::memory_order_seq_cst);
+
+        // No reader uses the other copy, update it and point new readers at it
+        instances[1 - current] = staging;
+        leftRight.store(1 - current, std::memory_order_seq_cst);
+
+        // Wait for the readers which may still use the previous copy, then update it
+        toggleVersionAndWait();
+        instances[current] = staging;
+        publishCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Get Publish Count.
+     * @return number of publish() calls.
+     */
+    unsigned long getPublishCount() const {
+        return publishCount.load(std::memory_order_relaxed);
+    }
+
+private:
+    // marks a reader as active for its scope.
+    struct ReaderGuard {
+        std::atomic<unsigned int>& count;
+        explicit ReaderGuard(std::atomic<unsigned int>& c) : count(c) { count.fetch_add(1, std::memory_order_seq_cst); }
+        ~ReaderGuard() { count.fetch_sub(1, std::memory_order_release); }
+    };
+
+    // the two published copies and the writer's copy.
+    TableType instances[2];
+    TableType staging;
+    // copy new readers use.
+    std::atomic<unsigned int> leftRight{0};
+    // reader counters, new readers arrive on versionIndex.
+    std::atomic<unsigned int> versionIndex{0};
+    mutable std::atomic<unsigned int> readers[2] = {{0}, {0}};
+    std::atomic<unsigned long> publishCount{0};
+    std::mutex writerMutex;
+
+    /**
+     * Moves new readers to the other counter, then waits until no reader is
+     * counted on either, so none can still use the previous copy.
+     */
+    void toggleVersionAndWait() {
+        const unsigned int previous = versionIndex.load(std::memory_order_seq_cst);
+        const unsigned int next = 1 - previous;
+        while (readers[next].load(std::memory_order_acquire) != 0) std::this_thread::yield();
+        versionIndex.store(next, std::memory_order_seq_cst);
+        while (readers[previous].load(std::memory_order_acquire) != 0) std::this_thread::yield();
+    }
+};
+
+#endif // EPICECU_CONCURRENT_TABLE_H
@@ -0,0 +1,369 @@
+#ifndef EPICECU_FIXED_AXIS_TABLE_H
+#define EPICECU_FIXED_AXIS_TABLE_H
+
+/**
+ * Fixed Axis Table.
+ *
+ * A Table whose breakpoints are template parameters, for axes which never change
+ * after design, e.g. the RPM breakpoints of an engine family:
+ *
+ *   typedef FixedTableAxis<int, 500, 1000, 2000, 3000, 4500, 6000> RpmAxis;
+ *   typedef FixedTableAxis<int, 20, 40, 60, 80, 100> MapAxis;
+ *   FixedAxisTable<uint8_t, RpmAxis, MapAxis> fuelMap;
+ *
+ * The segment search of each axis is unrolled by the compiler into a balanced tree
+ * of compares against constants, and the reciprocal width of each segment is folded
+ * into a constant, so a lookup has no loop, no axis load and no division. Only the
+ * values live in RAM, sizeof(fuelMap) is xSize * ySize * sizeof(T).
+ *
+ * The search is log2(size) compares deep, and the code of each axis grows with its
+ * number of breakpoints. Values are read and written by index or as a Table image,
+ * loadData accepts images whose axes match the breakpoints.
+ *
+ * For integer axes only, as C++ template parameters cannot be floating point.
+ *
+ * Copyright © 2022 David Cedar. All rights reserved.
+ * Licensed under the LGPL License (see LICENSE file)
+ */
+
+#include "Table.h"
+
+/**
+ * Breakpoints of a fixed axis, sorted ascending.
+ * @tparam AxisT the axis value type, an integer type.
+ * @tparam breakpoints the axis values.
+ */
+template<typename AxisT, AxisT... breakpoints>
+struct FixedTableAxis {
+    typedef AxisT Type;
+
+    static constexpr unsigned int size = sizeof...(breakpoints);
+    static constexpr AxisT values[size] = {breakpoints...};
+
+    static_assert(size > 0, "A FixedTableAxis needs at least one breakpoint");
+
+    /**
+     * Is Ascending.
+     * @return true if each breakpoint from i on is above the one before it.
+     */
+    static constexpr bool isAscending(const unsigned int i = 1) {
+        return i >= size || (values[i - 1] < values[i] && isAscending(i + 1));
+    }
+
+    /**
+     * Reciprocal.
+     * @return 1 / width of segment i, 0 for the last breakpoint.
+     */
+    template<typename ComputeT>
+    static constexpr ComputeT reciprocal(const unsigned int i) {
+        return i + 1 < size ? static_cast<ComputeT>(1) / static_cast<ComputeT>(values[i + 1] - values[i]) : static_cast<ComputeT>(0);
+    }
+
+    /**
+     * Segment search over the segments [lo, hi), unrolled into a tree of compares.
+     * An input on a breakpoint is in the segment above it, the last breakpoint is in the last segment.
+     */
+    template<unsigned int lo, unsigned int hi, bool leaf = (hi - lo <= 1)>
+    struct Search {
+        static constexpr unsigned int mid = (lo + hi) / 2;
+
+        template<typename ComputeT>
+        static void find(const AxisT in, unsigned int& idx, ComputeT& weight) {
+            if (in < values[mid]) {
+                Search<lo, mid>::find(in, idx, weight);
+            } else {
+                Search<mid, hi>::find(in, idx, weight);
+            }
+        }
+    };
+
+    template<unsigned int lo, unsigned int hi>
+    struct Search<lo, hi, true> {
+        template<typename ComputeT>
+        static void find(const AxisT in, unsigned int& idx, ComputeT& weight) {
+            constexpr ComputeT r = reciprocal<ComputeT>(lo);
+            idx = lo;
+            weight = static_cast<ComputeT>(in - values[lo]) * r;
+            // Return the last breakpoint exactly
+            if (lo + 2 == size && in == values[size - 1]) weight = 1;
+        }
+    };
+
+    /**
+     * Find.
+     * @param in the axis input value, within the axis bounds.
+     * @param idx set to the index i of the lower breakpoint, such that values[i] <= in <= values[i+1].
+     * @param weight set to (in - values[i]) / (values[i+1] - values[i]), 0 for a single breakpoint.
+     */
+    template<typename ComputeT>
+    static void find(const AxisT in, unsigned int& idx, ComputeT& weight) {
+        Search<0, (size > 1 ? size - 1 : 1)>::find(in, idx, weight);
+    }
+};
+
+template<typename AxisT, AxisT... breakpoints>
+constexpr AxisT FixedTableAxis<AxisT, breakpoints...>::values[];
+
+template<typename T, typename XAxis, typename YAxis = FixedTableAxis<int, 1>, typename ComputeT = double>
+class FixedAxisTable {
+public:
+    typedef typename XAxis::Type XAxisT;
+    typedef typename YAxis::Type YAxisT;
+
+    static constexpr unsigned int xSize = XAxis::size;
+    static constexpr unsigned int ySize = YAxis::size;
+
+    static_assert(XAxis::isAscending(), "The x-axis breakpoints must be sorted ascending");
+    static_assert(YAxis::isAscending(), "The y-axis breakpoints must be sorted ascending");
+
+    /**
+     * Constructs an empty table, initialise() and the setters fill it at run time.
+     */
+    FixedAxisTable() = default;
+
+    /**
+     * Constructs a table from its values.
+     * With C++14 this is constexpr, so a constexpr or const table is placed in read only memory.
+     * @param data the table values, the y values of each x index in turn.
+     */
+    TABLE_CONSTEXPR14 FixedAxisTable(const T (&data)[xSize * ySize]) {
+        for (unsigned int i = 0; i < xSize * ySize; i++) {
+            values[i] = data[i];
+        }
+    }
+
+    /**
+     * Initialises the table object.
+     */
+    void initialise() {
+        resetData();
+    }
+
+    /**
+     * Gets the table value by x,y axis value/s.
+     * @param X_in The x-axis value.
+     * @param Y_in The y-axis value.
+     * @returns The table value. -1 if out of bounds.
+     */
+    ComputeT getValue(const XAxisT X_in, const YAxisT Y_in) const {
+        // Check if requesting over bounds
+        if (X_in > XAxis::values[xSize - 1] || Y_in > YAxis::values[ySize - 1] || X_in < XAxis::values[0] || Y_in < YAxis::values[0]) {
+            return -1;
+        }
+        unsigned int xMinIdx, yMinIdx;
+        ComputeT wx, wy;
+        XAxis::find(X_in, xMinIdx, wx);
+        YAxis::find(Y_in, yMinIdx, wy);
+        const unsigned int xMaxIdx = xSize > 1 ? xMinIdx + 1 : xMinIdx;
+        const unsigned int yMaxIdx = ySize > 1 ? yMinIdx + 1 : yMinIdx;
+
+        const ComputeT q11 = getValueByIndex(xMinIdx, yMinIdx);
+        const ComputeT q21 = getValueByIndex(xMaxIdx, yMinIdx);
+        const ComputeT r1 = q11 + (q21 - q11) * wx;
+        if (ySize == 1) {
+            return r1;
+        }
+        const ComputeT q12 = getValueByIndex(xMinIdx, yMaxIdx);
+        const ComputeT q22 = getValueByIndex(xMaxIdx, yMaxIdx);
+        const ComputeT r2 = q12 + (q22 - q12) * wx;
+        return r1 + (r2 - r1) * wy;
+    }
+
+    /**
+     * Gets the table value by x axis value.
+     * @param X_in The x-axis value.
+     * @returns The table value. -1 if out of bounds.
+     */
+    ComputeT getValue(const XAxisT X_in) const {
+        return getValue(X_in, YAxis::values[0]);
+    }
+
+    /**
+     * Gets a batch of table values by x,y axis values.
+     * @param X_in array of x-axis values.
+     * @param Y_in array of y-axis values.
+     * @param out array receiving the table values. -1 where out of bounds.
+     * @param count number of values.
+     */
+    void getValues(const XAxisT* X_in, const YAxisT* Y_in, ComputeT* out, const unsigned int count) const {
+        for (unsigned int i = 0; i < count; i++) {
+            out[i] = getValue(X_in[i], Y_in[i]);
+        }
+    }
+
+    /**
+     * Gets a batch of table values by x axis values.
+     * @param X_in array of x-axis values.
+     * @param out array receiving the table values. -1 where out of bounds.
+     * @param count number of values.
+     */
+    void getValues(const XAxisT* X_in, ComputeT* out, const unsigned int count) const {
+        for (unsigned int i = 0; i < count; i++) {
+            out[i] = getValue(X_in[i]);
+        }
+    }
+
+    /**
+     * Set Value by X and Y Index.
+     * @param x index of the row in the table.
+     * @param y index of the column in the table.
+     * @param value to set.
+     * @returns True if the value was set successfully, False otherwise.
+     */
+    bool setValueByIndex(const unsigned int x, const unsigned int y, const T value) {
+        if (x >= xSize || y >= ySize) {
+            return false;
+        }
+        values[x * ySize + y] = value;
+        return true;
+    }
+
+    /**
+     * Set Value by X Index.
+     * @param x index of the row in the table.
+     * @param value to set.
+     * @returns True if the value was set successfully, False otherwise.
+     */
+    bool setValueByIndex(const unsigned int x, const T value) {
+        return setValueByIndex(x, 0, value);
+    }
+
+    /**
+     * Get Value by X and Y index.
+     * @param x index of the row in the table.
+     * @param y index of the column in the table.
+     * @return value at index (x,y).
+     */
+    TABLE_CONSTEXPR14 T getValueByIndex(const unsigned int x, const unsigned int y) const {
+        return values[x * ySize + y];
+    }
+
+    /**
+     * Get Value by X index.
+     * @param x index of the row in the table.
+     * @return value at index x.
+     */
+    TABLE_CONSTEXPR14 T getValueByIndex(const unsigned int x) const {
+        return getValueByIndex(x, 0);
+    }
+
+    /**
+     * Get X Axis Value by Index.
+     * @param x index of the x-axis breakpoint.
+     * @return the breakpoint.
+     */
+    static constexpr XAxisT getXAxisValueByIndex(const unsigned int x) {
+        return XAxis::values[x];
+    }
+
+    /**
+     * Get Y Axis Value by Index.
+     * @param y index of the y-axis breakpoint.
+     * @return the breakpoint.
+     */
+    static constexpr YAxisT getYAxisValueByIndex(const unsigned int y) {
+        return YAxis::values[y];
+    }
+
+    /**
+     * Sets every value of the table.
+     * @param data the table values, the y values of each x index in turn.
+     * @param count number of values, xSize * ySize.
+     * @returns True if the values were set, False if count is wrong.
+     */
+    bool setPlane(const T* data, const unsigned int count) {
+        if (count != xSize * ySize) {
+            return false;
+        }
+        memcpy(values, data, sizeof(values));
+        return true;
+    }
+
+    /**
+     * Sets every value of the table to one value.
+     * @param value to set.
+     */
+    void fill(const T value) {
+        for (auto& e : values) e = value;
+    }
+
+    /**
+     * Load table data from a buffer.
+     * The buffer holds a Table image, see TableImage.h, whose axes must equal the breakpoints.
+     * @param buffer pointer to the data buffer.
+     * @param size size of the buffer in bytes.
+     * @returns true if data was loaded successfully.
+     */
+    bool loadData(const char* buffer, unsigned int size) {
+        const unsigned char* image = reinterpret_cast<const unsigned char*>(buffer);
+        bool swapped = false;
+        if (!Image::check(image, size, swapped)) {
+            return false;
+        }
+
+        // Check the axes of the image
+        XAxisT axisX[xSize];
+        YAxisT axisY[ySize];
+        memcpy(axisX, image + Image::xAxisOffset(), sizeof(axisX));
+        memcpy(axisY, image + Image::yAxisOffset(), sizeof(axisY));
+        if (swapped) {
+            TableImageFormat::swapBytes(axisX, sizeof(XAxisT), xSize);
+            TableImageFormat::swapBytes(axisY, sizeof(YAxisT), ySize);
+        }
+        for (unsigned int x = 0; x < xSize; x++) {
+            if (axisX[x] != XAxis::values[x]) return false;
+        }
+        for (unsigned int y = 0; y < ySize; y++) {
+            if (axisY[y] != YAxis::values[y]) return false;
+        }
+
+        memcpy(values, image + Image::valuesOffset(), sizeof(values));
+        if (swapped) {
+            TableImageFormat::swapBytes(values, sizeof(T), xSize * ySize);
+        }
+        return true;
+    }
+
+    /**
+     * Save table data to a buffer, as a Table image with the breakpoints as its axes.
+     * @param buffer pointer to the output buffer.
+     * @param size size of the buffer in bytes, getSize().
+     * @returns true if data was saved successfully.
+     */
+    bool saveData(char* buffer, unsigned int size) const {
+        if (size != getSize()) {
+            return false;
+        }
+        unsigned char* image = reinterpret_cast<unsigned char*>(buffer);
+        Image::writeHeader(image);
+        memcpy(image + Image::valuesOffset(), values, sizeof(values));
+        memcpy(image + Image::xAxisOffset(), XAxis::values, sizeof(XAxisT) * xSize);
+        memcpy(image + Image::yAxisOffset(), YAxis::values, sizeof(YAxisT) * ySize);
+        Image::writeCrc(image);
+        return true;
+    }
+
+    /**
+     * Reset the data to zero.
+     */
+    void resetData() {
+        for (auto& e : values) e = 0;
+    }
+
+    /**
+     * Get Size.
+     * @return size of the saved table image in bytes.
+     */
+    static constexpr unsigned int getSize() {
+        return Image::size();
+    }
+
+private:
+    // binary image format of loadData and saveData, the same as a Table of these sizes and types.
+    typedef TableImage<T, xSize, ySize, XAxisT, YAxisT> Image;
+
+    // table values, the y values of each x index in turn.
+    T values[xSize * ySize] = {0};
+};
+
+#endif // EPICECU_FIXED_AXIS_TABLE_H
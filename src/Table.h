@@ -1,10 +1,83 @@
 #ifndef EPICECU_TABLE_H
 #define EPICECU_TABLE_H
 
+#include "TableConfig.h"
+#include "TableImage.h"
+#include "TableStats.h"
+
+/**
+ * Row major layout.
+ * The values of one x index are stored next to each other. The default layout.
+ */
+struct TableRowMajor {
+    // the values are in the order of the saved image.
+    static constexpr bool contiguous = true;
+
+    template<unsigned int xSize, unsigned int ySize>
+    static constexpr unsigned int size(){
+        return xSize * ySize;
+    }
+
+    template<unsigned int xSize, unsigned int ySize>
+    static constexpr unsigned int index(const unsigned int x, const unsigned int y){
+        return x * ySize + y;
+    }
+};
+
+/**
+ * Column major layout.
+ * The values of one y index are stored next to each other.
+ */
+struct TableColumnMajor {
+    static constexpr bool contiguous = false;
+
+    template<unsigned int xSize, unsigned int ySize>
+    static constexpr unsigned int size(){
+        return xSize * ySize;
+    }
+
+    template<unsigned int xSize, unsigned int ySize>
+    static constexpr unsigned int index(const unsigned int x, const unsigned int y){
+        return y * xSize + x;
+    }
+};
+
+/**
+ * Tiled layout.
+ * The values are stored in square tiles, so the four corners of a cell usually share a
+ * cache line. For large tables, the storage is padded to a whole number of tiles.
+ * @tparam tileSize width of a tile, a power of two.
+ */
+template<unsigned int tileSize = 4>
+struct TableTiled {
+    static_assert(tileSize > 0 && (tileSize & (tileSize - 1)) == 0, "tileSize must be a power of two");
+
+    static constexpr bool contiguous = false;
+
+    template<unsigned int xSize, unsigned int ySize>
+    static constexpr unsigned int size(){
+        return ((xSize + tileSize - 1) / tileSize) * ((ySize + tileSize - 1) / tileSize) * tileSize * tileSize;
+    }
+
+    template<unsigned int xSize, unsigned int ySize>
+    static constexpr unsigned int index(const unsigned int x, const unsigned int y){
+        return ((x / tileSize) * ((ySize + tileSize - 1) / tileSize) + y / tileSize) * tileSize * tileSize
+               + (x % tileSize) * tileSize + y % tileSize;
+    }
+};
+
 /**
  * Table.
  * 
  * A Table implementation with bilinear interpolation support between points.
+ * The interpolation is computed in ComputeT, double by default. Use float on
+ * targets with a single precision FPU. The Layout sets the order of the values
+ * in memory, see TableRowMajor, TableColumnMajor and TableTiled. CacheSize is
+ * the number of recent results kept by each lookup context: 1 for a single
+ * consumer, one per consumer when a table is read round-robin, or 0 to disable.
+ * Stats is the instrumentation policy of the lookups, see TableStats.h. Index is
+ * the axis search, TableIndexLut<bits> replaces it with a look up table on integer
+ * axes, see TableIndex.h.
  * 
  * Author: David Cedar
  * Email: david@epicecu.com
@@ -13,18 +86,288 @@
  * Copyright © 2022 David Cedar. All rights reserved.
  * Licensed under the LGPL License (see LICENSE file)
  */
-template<typename T, unsigned int xSize, unsigned int ySize = 1, typename XAxisT = int, typename YAxisT = int>
-class Table {
+
+#include "TableIndex.h"
+
+template<typename T, unsigned int xSize, unsigned int ySize = 1, typename XAxisT = int, typename YAxisT = int, typename ComputeT = double>
+class TableView;
+
+template<typename T, typename ComputeT, typename... Axes>
+class BasicTableND;
+
+template<typename T, unsigned int K, unsigned int xSize, unsigned int ySize = 1, typename XAxisT = int, typename YAxisT = int, typename ComputeT = double>
+class TableSet;
+
+struct TableGrid;
+
+template<typename T, unsigned int xSize, unsigned int ySize = 1, typename XAxisT = int, typename YAxisT = int, typename ComputeT = double>
+class CompiledTable;
+
+/**
+ * Lookup Cache.
+ * The recent results of a lookup context, the table and revision they came from, and the
+ * hit and miss counters. Empty when CacheSize is 0, the counters then read 0.
+ */
+template<typename XAxisT, typename YAxisT, typename ComputeT, unsigned int CacheSize>
+class TableLookupCache {
+    static_assert(CacheSize < 256, "CacheSize must be below 256");
+
 public:
+    /**
+     * Get Result Cache Hits.
+     * @return number of lookups answered with the cached result.
+     */
+    unsigned long getResultCacheHits() const {
+        return resultCacheHits;
+    }
+
+    /**
+     * Get Bracket Cache Hits.
+     * @return number of lookups whose cell was found at, or next to, the previous cell.
+     */
+    unsigned long getBracketCacheHits() const {
+        return bracketCacheHits;
+    }
+
+    /**
+     * Get Bracket Cache Misses.
+     * @return number of lookups which required a full search of an axis.
+     */
+    unsigned long getBracketCacheMisses() const {
+        return bracketCacheMisses;
+    }
+
+    /**
+     * Reset the hit and miss counters.
+     */
+    void resetStats(){
+        resultCacheHits = 0;
+        bracketCacheHits = 0;
+        bracketCacheMisses = 0;
+    }
+
+    /**
+     * Invalidate the cached results.
+     */
+    void invalidate(){
+        owner = nullptr;
+    }
+
+protected:
+    /**
+     * Find a cached result, and drop the results of another table or revision.
+     * @return true if the output was cached.
+     */
+    bool find(const void* table, const uint32_t tableRevision, const XAxisT X_in, const YAxisT Y_in, ComputeT& output){
+        if(owner != table || revision != tableRevision){
+            owner = table;
+            revision = tableRevision;
+            used = 0;
+            next = 0;
+            return false;
+        }
+        for(unsigned int i = 0; i < used; i++){
+            if(X_in == entries[i].X_in && Y_in == entries[i].Y_in){
+                resultCacheHits++;
+                output = entries[i].output;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Store a result, replacing the oldest once all are used.
+     */
+    void store(const XAxisT X_in, const YAxisT Y_in, const ComputeT output){
+        Entry& entry = entries[next];
+        entry.X_in = X_in;
+        entry.Y_in = Y_in;
+        entry.output = output;
+        next = next + 1u < CacheSize ? next + 1 : 0;
+        if(used < CacheSize) used++;
+    }
+
+    /**
+     * Count a lookup by whether its cell was found next to the previous cell.
+     */
+    void bracket(const bool near){
+        if(near){
+            bracketCacheHits++;
+        }else{
+            bracketCacheMisses++;
+        }
+    }
+
+private:
+    // a cached result.
+    struct Entry {
+        XAxisT X_in = 0;
+        YAxisT Y_in = 0;
+        ComputeT output = 0;
+    };
+
+    Entry entries[CacheSize];
+    // table and revision of the cached results.
+    const void* owner = nullptr;
+    uint32_t revision = 0;
+    uint8_t used = 0;
+    uint8_t next = 0;
+    uint32_t resultCacheHits = 0;
+    uint32_t bracketCacheHits = 0;
+    uint32_t bracketCacheMisses = 0;
+};
+
+template<typename XAxisT, typename YAxisT, typename ComputeT>
+class TableLookupCache<XAxisT, YAxisT, ComputeT, 0> {
+public:
+    unsigned long getResultCacheHits() const {
+        return 0;
+    }
+
+    unsigned long getBracketCacheHits() const {
+        return 0;
+    }
+
+    unsigned long getBracketCacheMisses() const {
+        return 0;
+    }
+
+    void resetStats(){}
+
+    void invalidate(){}
+
+protected:
+    bool find(const void*, const uint32_t, const XAxisT, const YAxisT, ComputeT&){
+        return false;
+    }
+
+    void store(const XAxisT, const YAxisT, const ComputeT){}
+
+    void bracket(const bool){}
+};
+
+/**
+ * Table Revision.
+ * Changed by every edit of a table, cached results of an older revision are not used.
+ * A copy is an edit too, it takes a revision past both the table copied and the one
+ * replaced, so a context holding a result of either does not match the copy.
+ * Empty when the table caches no results.
+ */
+template<bool enabled>
+class TableRevision {
+public:
+    TableRevision() = default;
+
+    TABLE_CONSTEXPR14 TableRevision(const TableRevision& other) : count(other.count + 1) {}
+
+    TableRevision& operator=(const TableRevision& other){
+        count = (count > other.count ? count : other.count) + 1;
+        return *this;
+    }
+
+protected:
+    uint32_t revision() const {
+        return count;
+    }
+
+    void changed(){
+        count++;
+    }
+
+private:
+    uint32_t count = 0;
+};
+
+template<>
+class TableRevision<false> {
+protected:
+    uint32_t revision() const {
+        return 0;
+    }
+
+    void changed(){}
+};
+
+template<typename T, unsigned int xSize, unsigned int ySize = 1, typename XAxisT = int, typename YAxisT = int, typename ComputeT = double, typename Layout = TableRowMajor, unsigned int CacheSize = 1, typename Stats = TableNoStats, typename Index = TableSearchIndex>
+class Table : private Stats, private TableRevision<(CacheSize > 0)>, private TableAxisIndexes<Index, XAxisT, xSize, YAxisT, ySize> {
+    // views, N dimensional, compiled tables, table sets and grids share the lookup functions.
+    template<typename, unsigned int, unsigned int, typename, typename, typename> friend class TableView;
+    template<typename, typename, typename...> friend class BasicTableND;
+    template<typename, unsigned int, unsigned int, typename, typename, typename> friend class CompiledTable;
+    template<typename, unsigned int, unsigned int, unsigned int, typename, typename, typename> friend class TableSet;
+    friend struct TableGrid;
+
+public:
+    /**
+     * Lookup Context.
+     * The lookup state of one consumer of a table: its last CacheSize inputs and results, and its last cell.
+     * Consumers reading the same table with different inputs each own a context and pass
+     * it to the const getValue, so they keep their own cache and the table is not modified.
+     * A cached result is used only with the table it came from, and only until that table is changed.
+     */
+    class LookupContext : public TableLookupCache<XAxisT, YAxisT, ComputeT, CacheSize> {
+    private:
+        friend class Table;
+
+        // bracket caching.
+        unsigned int lastXIdx = 0;
+        unsigned int lastYIdx = 0;
+    };
+
+    /**
+     * Constructs an empty Table, initialise() and the setters fill it at run time.
+     */
+    Table() = default;
+
+    /**
+     * Constructs a Table from its axes and values.
+     * With C++14 this is constexpr, so a constexpr or const Table is placed in read only
+     * memory with no start up initialisation. Use the const getValue to look up such a table.
+     * @param xAxis the x-axis values, sorted ascending.
+     * @param yAxis the y-axis values, sorted ascending.
+     * @param data the table values, the y values of each x index in turn.
+     */
+    TABLE_CONSTEXPR14 Table(const XAxisT (&xAxis)[xSize], const YAxisT (&yAxis)[ySize], const T (&data)[xSize * ySize]) {
+        for (unsigned int x = 0; x < xSize; x++) {
+            axisX[x] = xAxis[x];
+            for (unsigned int y = 0; y < ySize; y++) {
+                values[Layout::template index<xSize, ySize>(x, y)] = data[x * ySize + y];
+            }
+        }
+        for (unsigned int y = 0; y < ySize; y++) {
+            axisY[y] = yAxis[y];
+        }
+        xSpacing = detectSpacing(axisX, xSize);
+        ySpacing = detectSpacing(axisY, ySize);
+        xIndex.build(axisX);
+        yIndex.build(axisY);
+    }
+
+    /**
+     * Constructs a (x, 1) sized Table from its axis and values.
+     * @param xAxis the x-axis values, sorted ascending.
+     * @param data the table values.
+     */
+    TABLE_CONSTEXPR14 Table(const XAxisT (&xAxis)[xSize], const T (&data)[xSize]) {
+        static_assert(ySize == 1, "A Table with a y-axis needs the y-axis values");
+        for (unsigned int x = 0; x < xSize; x++) {
+            axisX[x] = xAxis[x];
+            values[Layout::template index<xSize, ySize>(x, 0)] = data[x];
+        }
+        axisY[0] = 1;
+        xSpacing = detectSpacing(axisX, xSize);
+        xIndex.build(axisX);
+        yIndex.build(axisY);
+    }
+
     /**
      * Initialises the Table object.
      */
     void initialise() {
         resetData();
-        cacheIsValid = false;
         if(ySize == 1) axisY[0] = 1;
-        lastX_in=0;
-        lastY_in=0;
+        cache = LookupContext();
     }
     
     /**
@@ -33,132 +376,277 @@ public:
      * @param Y_in The y-axis value.
      * @returns The table value. -1 if out of bounds.
      */
-    double getValue(const XAxisT X_in, const YAxisT Y_in) {
-        double tableResult = -1;
+    ComputeT getValue(const XAxisT X_in, const YAxisT Y_in) {
+        buildAxisIndexes();
+        return getValue(X_in, Y_in, cache);
+    }
+
+    /**
+     * Retrieves the value of a specific position.
+     * @param X_in The x-axis value.
+     * @returns The value at the specified position. If the position is outside of the table bounds, returns a default value.
+     */
+    ComputeT getValue(const XAxisT X_in) {
+        return getValue(X_in, 1);
+    }
+
+    /**
+     * Gets the value table value by x,y axis value/s, without the cache.
+     * Used for const and read only tables, the table is not modified.
+     * @param X_in The x-axis value.
+     * @param Y_in The y-axis value.
+     * @returns The table value. -1 if out of bounds.
+     */
+    ComputeT getValue(const XAxisT X_in, const YAxisT Y_in) const {
+        typename Stats::Scope scope(*this);
+
+        // Check if requesting over bounds
+        if(X_in > axisX[xSize-1] || Y_in > axisY[ySize-1] || X_in < axisX[0] || Y_in < axisY[0]){
+           Stats::outOfBounds();
+           return -1;
+        }
+        Stats::searchSteps((xIndex.ready() || xSpacing.uniform ? 1 : searchDepth(xSize)) + (yIndex.ready() || ySpacing.uniform ? 1 : searchDepth(ySize)));
+        return interpolate(values, axisX, axisY, X_in, Y_in, findSegment(axisX, xSize, xSpacing, xIndex, X_in), findSegment(axisY, ySize, ySpacing, yIndex, Y_in), *this);
+    }
+
+    /**
+     * Retrieves the value of a specific position, without the cache.
+     * @param X_in The x-axis value.
+     * @returns The table value. -1 if out of bounds.
+     */
+    ComputeT getValue(const XAxisT X_in) const {
+        return getValue(X_in, 1);
+    }
+
+    /**
+     * Gets the value table value by x,y axis value/s, using the caller's lookup context.
+     * The table is not modified, so several consumers can share a const table.
+     * @param X_in The x-axis value.
+     * @param Y_in The y-axis value.
+     * @param context the caller's lookup state.
+     * @returns The table value. -1 if out of bounds.
+     */
+    ComputeT getValue(const XAxisT X_in, const YAxisT Y_in, LookupContext& context) const {
+        typename Stats::Scope scope(*this);
 
         // Check if requesting over bounds
         if(X_in > axisX[xSize-1] || Y_in > axisY[ySize-1] || X_in < axisX[0] || Y_in < axisY[0]){
-           return tableResult; 
+           Stats::outOfBounds();
+           return -1;
         }
 
         // Load cache
-        if(X_in == lastX_in && Y_in == lastY_in){
-            if(cacheIsValid){
-                return lastOutput;
-            }
-        }else{
-            cacheIsValid = false;
+        ComputeT tableResult = 0;
+        if(context.find(this, Revision::revision(), X_in, Y_in, tableResult)){
+            Stats::resultCacheHit();
+            return tableResult;
         }
 
-        // Check if requesting a direct value
-        int x = -1;
-        int y = -1;
-        for (unsigned int i = 0; i < xSize; i++){
-            if(X_in == axisX[i]) x = i;
+        // Find the cell containing the input, starting at the previous cell
+        bool xNear = findSegmentFast(axisX, xSize, xSpacing, xIndex, X_in, context.lastXIdx);
+        bool yNear = findSegmentFast(axisY, ySize, ySpacing, yIndex, Y_in, context.lastYIdx);
+        context.bracket(xNear && yNear);
+        Stats::searchSteps((xNear ? 1 : 1 + searchDepth(xSize)) + (yNear ? 1 : 1 + searchDepth(ySize)));
+        tableResult = interpolate(values, axisX, axisY, X_in, Y_in, context.lastXIdx, context.lastYIdx, *this);
+
+        // Cache result
+        context.store(X_in, Y_in, tableResult);
+
+        return tableResult;
+    }
+
+    /**
+     * Retrieves the value of a specific position, using the caller's lookup context.
+     * @param X_in The x-axis value.
+     * @param context the caller's lookup state.
+     * @returns The table value. -1 if out of bounds.
+     */
+    ComputeT getValue(const XAxisT X_in, LookupContext& context) const {
+        return getValue(X_in, 1, context);
+    }
+
+    /**
+     * Gets the table value by x,y axis value/s using integer arithmetic only.
+     * For targets without an FPU. The interpolation weights are FracBits wide, and are found
+     * with a shift or reciprocal multiply on evenly spaced axes, or an integer division otherwise.
+     * The result is within (2 * D + 1) / 2^FracBits of getValue, where D is the largest
+     * difference between neighbouring cells.
+     * @tparam FracBits number of fractional bits of the weights and of the result.
+     * @tparam AccT accumulator type, must hold the largest table value times 2^(2 * FracBits + 1).
+     * @param X_in The x-axis value.
+     * @param Y_in The y-axis value.
+     * @returns The table value scaled by 2^FracBits. -1 scaled by 2^FracBits if out of bounds.
+     */
+    template<unsigned int FracBits = 8, typename AccT = long>
+    AccT getValueFixed(const XAxisT X_in, const YAxisT Y_in) {
+        const AccT one = static_cast<AccT>(1) << FracBits;
+        buildAxisIndexes();
+
+        // Check if requesting over bounds
+        if(X_in > axisX[xSize-1] || Y_in > axisY[ySize-1] || X_in < axisX[0] || Y_in < axisY[0]){
+            return -one;
         }
-        for (unsigned int i = 0; i < ySize; i++){
-            if(Y_in == axisY[i]) y = i;
+
+        findSegmentFast(axisX, xSize, xSpacing, xIndex, X_in, cache.lastXIdx);
+        findSegmentFast(axisY, ySize, ySpacing, yIndex, Y_in, cache.lastYIdx);
+        const unsigned int xMinIdx = cache.lastXIdx;
+        const unsigned int yMinIdx = cache.lastYIdx;
+        const unsigned int xMaxIdx = xSize > 1 ? xMinIdx + 1 : xMinIdx;
+        const unsigned int yMaxIdx = ySize > 1 ? yMinIdx + 1 : yMinIdx;
+        const AccT wx = segmentWeight<FracBits, AccT>(axisX, xSize, xSpacing, xMinIdx, X_in);
+        const AccT wy = segmentWeight<FracBits, AccT>(axisY, ySize, ySpacing, yMinIdx, Y_in);
+
+        const AccT q11 = getValueByIndex(xMinIdx, yMinIdx);
+        const AccT q12 = getValueByIndex(xMinIdx, yMaxIdx);
+        const AccT q21 = getValueByIndex(xMaxIdx, yMinIdx);
+        const AccT q22 = getValueByIndex(xMaxIdx, yMaxIdx);
+
+        // Interpolate along x, then along y, rounding once at the end
+        const AccT r1 = q11 * one + (q21 - q11) * wx;
+        const AccT r2 = q12 * one + (q22 - q12) * wx;
+        return (r1 * one + (r2 - r1) * wy + (one >> 1)) >> FracBits;
+    }
+
+    /**
+     * Gets the table value by x axis value using integer arithmetic only.
+     * @param X_in The x-axis value.
+     * @returns The table value scaled by 2^FracBits. -1 scaled by 2^FracBits if out of bounds.
+     */
+    template<unsigned int FracBits = 8, typename AccT = long>
+    AccT getValueFixed(const XAxisT X_in) {
+        return getValueFixed<FracBits, AccT>(X_in, 1);
+    }
+
+    /**
+     * Gets the table value and its partial derivatives by x,y axis value/s.
+     * One search and one fetch of the cell corners give all three. Within a cell the table
+     * is bilinear, so dV/dX is linear in Y and dV/dY is linear in X. On a breakpoint the
+     * gradient is that of the cell above it, except on the last breakpoint.
+     * Starts the search of each axis at the previous cell.
+     * @param X_in The x-axis value.
+     * @param Y_in The y-axis value.
+     * @param dX set to dV/dX, 0 if out of bounds or the table has one x index.
+     * @param dY set to dV/dY, 0 if out of bounds or the table has one y index.
+     * @returns The table value. -1 if out of bounds.
+     */
+    ComputeT getValueAndGradient(const XAxisT X_in, const YAxisT Y_in, ComputeT& dX, ComputeT& dY) {
+        dX = 0;
+        dY = 0;
+        if(X_in > axisX[xSize-1] || Y_in > axisY[ySize-1] || X_in < axisX[0] || Y_in < axisY[0]){
+            return -1;
         }
-        // Direct cell found, return the value
-        if (x >= 0 && y >= 0){
-            tableResult = getValueByIndex(x, y);
-        
-        // Interpolation is required
-        }else{
-            unsigned int xMinIdx = 0;
-            unsigned int yMinIdx = 0;
-            unsigned int xMaxIdx = 0;
-            unsigned int yMaxIdx = 0;
-            XAxisT xMin = 0; 
-            XAxisT xMax = 0; 
-            YAxisT yMin = 0; 
-            YAxisT yMax = 0;
-            // x-axis
-            for (unsigned int i = 0; i < xSize; i++){
-                if(X_in >= axisX[i]){
-                    if(i+1 < xSize){
-                        if(X_in <= axisX[i+1]){
-                            // Found the bounds in x axis
-                            xMinIdx = i;
-                            xMaxIdx = i+1;
-                        }
-                    }
-                }
-                else if(X_in == axisX[i]){
-                    if(i == xMax-1){
-                        xMinIdx = i-1;
-                        xMaxIdx = i;
-                    }else{
-                        xMinIdx = i;
-                        xMaxIdx = i+1;
-                    }
-                }else if(X_in == axisX[i] && xSize == 1){
-                    xMinIdx = i;
-                    xMaxIdx = i;
-                }
-                xMin = axisX[xMinIdx];
-                xMax = axisX[xMaxIdx];
-            }
-            // y-axis
-            for (unsigned int i = 0; i < ySize; i++){
-                if(Y_in >= axisY[i]){
-                    if(i+1 < ySize){
-                        if(Y_in <= axisY[i+1]){
-                            // Found the bounds in x axis
-                            yMinIdx = i;
-                            yMaxIdx = i+1;
-                        }
-                    }
-                }
-                else if(Y_in == axisY[i] && ySize > 1){
-                    if(i == yMax-1){
-                        yMinIdx = i-1;
-                        yMaxIdx = i;
-                    }else{
-                        yMinIdx = i;
-                        yMaxIdx = i+1;
-                    }
-                }else if(Y_in == axisY[i] && ySize == 1){
-                    yMinIdx = i;
-                    yMaxIdx = i;
-                }
-                yMin = axisY[yMinIdx];
-                yMax = axisY[yMaxIdx];
-            }
-            double Q11 = getValueByIndex(xMinIdx, yMinIdx);
-            double Q12 = getValueByIndex(xMinIdx, yMaxIdx);
-            double Q21 = getValueByIndex(xMaxIdx, yMinIdx);
-            double Q22 = getValueByIndex(xMaxIdx, yMaxIdx);
-
-            if(Q11 == Q12 && Q21 == Q22){
-                // 2d interpolation in a (x, 1) sized table
-                tableResult = linearInterpolation(Q11, Q21, xMin, xMax, X_in);
-            }else if(Q11 == Q21 && Q12 == Q22){
-                // 2d interpolation in a (1, y) sized table
-                tableResult = linearInterpolation(Q11, Q12, yMin, yMax, Y_in);
-            }else{
-                // 3d interpolation
-                tableResult = biLinearInterpolation(Q11, Q12, Q21, Q22, xMin, xMax, yMin, yMax, X_in, Y_in);
-            }
+        buildAxisIndexes();
+        findSegmentFast(axisX, xSize, xSpacing, xIndex, X_in, cache.lastXIdx);
+        findSegmentFast(axisY, ySize, ySpacing, yIndex, Y_in, cache.lastYIdx);
+        return gradient(X_in, Y_in, cache.lastXIdx, cache.lastYIdx, dX, dY);
+    }
+
+    /**
+     * Gets the table value and its derivative by x axis value.
+     * @param X_in The x-axis value.
+     * @param dX set to dV/dX, 0 if out of bounds.
+     * @returns The table value. -1 if out of bounds.
+     */
+    ComputeT getValueAndGradient(const XAxisT X_in, ComputeT& dX) {
+        ComputeT dY = 0;
+        return getValueAndGradient(X_in, 1, dX, dY);
+    }
 
+    /**
+     * Gets the table value and its partial derivatives by x,y axis value/s, without the cache.
+     * @param X_in The x-axis value.
+     * @param Y_in The y-axis value.
+     * @param dX set to dV/dX, 0 if out of bounds or the table has one x index.
+     * @param dY set to dV/dY, 0 if out of bounds or the table has one y index.
+     * @returns The table value. -1 if out of bounds.
+     */
+    ComputeT getValueAndGradient(const XAxisT X_in, const YAxisT Y_in, ComputeT& dX, ComputeT& dY) const {
+        dX = 0;
+        dY = 0;
+        if(X_in > axisX[xSize-1] || Y_in > axisY[ySize-1] || X_in < axisX[0] || Y_in < axisY[0]){
+            return -1;
         }
+        unsigned int xMinIdx = findSegment(axisX, xSize, xSpacing, xIndex, X_in);
+        unsigned int yMinIdx = findSegment(axisY, ySize, ySpacing, yIndex, Y_in);
+        return gradient(X_in, Y_in, xMinIdx, yMinIdx, dX, dY);
+    }
 
-        // Cache result
-        lastOutput = tableResult;
-        lastX_in = X_in;
-        lastY_in = Y_in;
-        cacheIsValid = true;
+    /**
+     * Gets a batch of table values by x,y axis values.
+     * The results match getValue to within rounding, the cache is neither read nor updated.
+     * This is a scalar loop, there is no SIMD path: the segment search and blend are
+     * dependent loads which gather instructions do not speed up.
+     * Uses (xSize + ySize) ComputeT of stack for the reciprocal segment widths.
+     * @param X_in array of x-axis values.
+     * @param Y_in array of y-axis values.
+     * @param out array receiving the table values. -1 where out of bounds.
+     * @param count number of values.
+     */
+    void getValues(const XAxisT* X_in, const YAxisT* Y_in, ComputeT* out, const unsigned int count) const {
+        getValuesStrided(X_in, Y_in, 1, out, count);
+    }
 
-        return tableResult;
+    /**
+     * Gets a batch of table values by x axis values.
+     * @param X_in array of x-axis values.
+     * @param out array receiving the table values. -1 where out of bounds.
+     * @param count number of values.
+     */
+    void getValues(const XAxisT* X_in, ComputeT* out, const unsigned int count) const {
+        const YAxisT Y_in = 1;
+        getValuesStrided(X_in, &Y_in, 0, out, count);
     }
 
     /**
-     * Retrieves the value of a specific position.
+     * Inverse lookup along the x-axis.
+     * Finds the x-axis value at which the table at Y_in has the target value. The y segment
+     * is found once, then the x segment by a binary search over the values interpolated at
+     * Y_in, and the x-axis value within it by solving the segment line.
+     * The values along x at Y_in must be monotonic, rising or falling. Where they are flat
+     * at the target, the lowest x-axis value of the flat segment is returned.
+     * @param target the table value.
+     * @param Y_in The y-axis value.
+     * @param X_out set to the x-axis value.
+     * @returns False if Y_in is out of bounds, the values are not monotonic or the target is not within them.
+     */
+    bool getXForValue(const ComputeT target, const YAxisT Y_in, ComputeT& X_out) const {
+        if(Y_in > axisY[ySize-1] || Y_in < axisY[0]){
+            return false;
+        }
+        const unsigned int yMinIdx = findSegment(axisY, ySize, ySpacing, yIndex, Y_in);
+        const unsigned int yMaxIdx = ySize > 1 ? yMinIdx + 1 : yMinIdx;
+        const ComputeT fy = yMaxIdx != yMinIdx ? static_cast<ComputeT>(Y_in - axisY[yMinIdx]) / static_cast<ComputeT>(axisY[yMaxIdx] - axisY[yMinIdx]) : 0;
+        return solveAxis(axisX, xSize, [this](const unsigned int x, const unsigned int y){ return getValueByIndex(x, y); },
+                         yMinIdx, yMaxIdx, fy, target, X_out);
+    }
+
+    /**
+     * Inverse lookup of a (x, 1) sized table.
+     * @param target the table value.
+     * @param X_out set to the x-axis value.
+     * @returns False if the values are not monotonic or the target is not within them.
+     */
+    bool getXForValue(const ComputeT target, ComputeT& X_out) const {
+        return getXForValue(target, axisY[0], X_out);
+    }
+
+    /**
+     * Inverse lookup along the y-axis.
+     * Finds the y-axis value at which the table at X_in has the target value, see getXForValue.
+     * @param target the table value.
      * @param X_in The x-axis value.
-     * @returns The value at the specified position. If the position is outside of the table bounds, returns a default value.
+     * @param Y_out set to the y-axis value.
+     * @returns False if X_in is out of bounds, the values are not monotonic or the target is not within them.
      */
-    double getValue(const XAxisT X_in) {
-        return getValue(X_in, 1);
+    bool getYForValue(const ComputeT target, const XAxisT X_in, ComputeT& Y_out) const {
+        if(X_in > axisX[xSize-1] || X_in < axisX[0]){
+            return false;
+        }
+        const unsigned int xMinIdx = findSegment(axisX, xSize, xSpacing, xIndex, X_in);
+        const unsigned int xMaxIdx = xSize > 1 ? xMinIdx + 1 : xMinIdx;
+        const ComputeT fx = xMaxIdx != xMinIdx ? static_cast<ComputeT>(X_in - axisX[xMinIdx]) / static_cast<ComputeT>(axisX[xMaxIdx] - axisX[xMinIdx]) : 0;
+        return solveAxis(axisY, ySize, [this](const unsigned int y, const unsigned int x){ return getValueByIndex(x, y); },
+                         xMinIdx, xMaxIdx, fx, target, Y_out);
     }
 
     /**
@@ -169,14 +657,8 @@ public:
      * @returns True if the value was set successfully, False otherwise. 
      */
     bool setValue(const XAxisT X_in, const YAxisT Y_in, const T value) {
-        int x = -1;
-        int y = -1;
-        for (unsigned int i = 0; i < xSize; i++){
-            if(X_in == axisX[i]) x = i;
-        }
-        for (unsigned int i = 0; i < ySize; i++){
-            if(Y_in == axisY[i]) y = i;
-        }
+        int x = findIndex(axisX, xSize, X_in);
+        int y = findIndex(axisY, ySize, Y_in);
         // Direct cell found, return the direct value
         if (x >= 0 && y >= 0){
             return setValueByIndex(x, y, value);
@@ -191,10 +673,7 @@ public:
      * @returns True if the value was set successfully, False otherwise. 
      */
     bool setValue(const XAxisT X_in, const T value){
-        int x = -1;
-        for (unsigned int i = 0; i < xSize; i++){
-            if(X_in == axisX[i]) x = i;
-        }
+        int x = findIndex(axisX, xSize, X_in);
         // Direct cell found, return the direct value
         if (x >= 0){
             return setValueByIndex(x, value);
@@ -213,7 +692,8 @@ public:
         if(x >= xSize || y >= ySize){
             return false;
         }
-        values[x * ySize + y] = value;
+        values[Layout::template index<xSize, ySize>(x, y)] = value;
+        Revision::changed();
         return true;
     }
 
@@ -233,8 +713,8 @@ public:
      * @param y index of the column in the table.
      * @return value at index (x,y).
      */
-    T getValueByIndex(const unsigned int x, const unsigned int y){
-        return values[x * ySize + y];
+    TABLE_CONSTEXPR14 T getValueByIndex(const unsigned int x, const unsigned int y) const {
+        return values[Layout::template index<xSize, ySize>(x, y)];
     }
 
     /**
@@ -242,12 +722,32 @@ public:
      * @param x index of the row in the table.
      * @return value at index x.
      */
-    T getValueByIndex(const unsigned int x){
+    TABLE_CONSTEXPR14 T getValueByIndex(const unsigned int x) const {
         return getValueByIndex(x, 0);
     }
 
+    /**
+     * Get X Axis Value by Index.
+     * @param x index of the breakpoint, within the axis.
+     * @return the breakpoint.
+     */
+    TABLE_CONSTEXPR14 XAxisT getXAxisValueByIndex(const unsigned int x) const {
+        return axisX[x];
+    }
+
+    /**
+     * Get Y Axis Value by Index.
+     * @param y index of the breakpoint, within the axis.
+     * @return the breakpoint.
+     */
+    TABLE_CONSTEXPR14 YAxisT getYAxisValueByIndex(const unsigned int y) const {
+        return axisY[y];
+    }
+
     /**
      * Set X Axis Value by Index.
+     * Setting the last breakpoint rebuilds the axis index. After any other breakpoint it is out of
+     * date until the next non-const lookup or buildAxisIndexes(), const lookups skip it until then.
      * @param x index of the row in the table.
      * @param value to set.
      * @returns True if the value was set successfully, False otherwise.
@@ -257,11 +757,20 @@ public:
             return false;
         }
         axisX[x] = value;
+        xSpacing = detectSpacing(axisX, xSize);
+        if(x == xSize - 1){
+            xIndex.build(axisX);
+        }else{
+            xIndex.invalidate();
+        }
+        Revision::changed();
         return true;
     }
 
     /**
      * Set Y Axis Value by Index.
+     * Setting the last breakpoint rebuilds the axis index. After any other breakpoint it is out of
+     * date until the next non-const lookup or buildAxisIndexes(), const lookups skip it until then.
      * @param y index of the column in the table.
      * @param value to set.
      * @returns True if the value was set successfully, False otherwise.
@@ -271,69 +780,200 @@ public:
             return false;
         }
         axisY[y] = value;
+        ySpacing = detectSpacing(axisY, ySize);
+        if(y == ySize - 1){
+            yIndex.build(axisY);
+        }else{
+            yIndex.invalidate();
+        }
+        Revision::changed();
+        return true;
+    }
+
+    /**
+     * Set X Axis.
+     * Replaces every x-axis breakpoint, the spacing and index of the axis are rebuilt once.
+     * @param axis the x-axis values, sorted strictly ascending.
+     * @param count number of values, xSize.
+     * @returns True if the axis was set, False if the count is wrong or the values are not ascending.
+     */
+    bool setXAxis(const XAxisT* axis, const unsigned int count){
+        if(count != xSize || !isAscending(axis, count)){
+            return false;
+        }
+        memcpy(axisX, axis, sizeof(axisX));
+        xSpacing = detectSpacing(axisX, xSize);
+        xIndex.build(axisX);
+        Revision::changed();
+        return true;
+    }
+
+    /**
+     * Set Y Axis.
+     * Replaces every y-axis breakpoint, the spacing and index of the axis are rebuilt once.
+     * @param axis the y-axis values, sorted strictly ascending.
+     * @param count number of values, ySize.
+     * @returns True if the axis was set, False if the count is wrong or the values are not ascending.
+     */
+    bool setYAxis(const YAxisT* axis, const unsigned int count){
+        if(count != ySize || !isAscending(axis, count)){
+            return false;
+        }
+        memcpy(axisY, axis, sizeof(axisY));
+        ySpacing = detectSpacing(axisY, ySize);
+        yIndex.build(axisY);
+        Revision::changed();
+        return true;
+    }
+
+    /**
+     * Set Row.
+     * @param x index of the row in the table.
+     * @param row the values of the row, one per y index.
+     * @param count number of values, ySize.
+     * @returns True if the row was set successfully, False otherwise.
+     */
+    bool setRow(const unsigned int x, const T* row, const unsigned int count){
+        if(x >= xSize || count != ySize){
+            return false;
+        }
+        if(Layout::contiguous){
+            memcpy(&values[Layout::template index<xSize, ySize>(x, 0)], row, ySize * sizeof(T));
+        }else{
+            for(unsigned int y = 0; y < ySize; y++) values[Layout::template index<xSize, ySize>(x, y)] = row[y];
+        }
+        Revision::changed();
+        return true;
+    }
+
+    /**
+     * Set Column.
+     * @param y index of the column in the table.
+     * @param column the values of the column, one per x index.
+     * @param count number of values, xSize.
+     * @returns True if the column was set successfully, False otherwise.
+     */
+    bool setColumn(const unsigned int y, const T* column, const unsigned int count){
+        if(y >= ySize || count != xSize){
+            return false;
+        }
+        for(unsigned int x = 0; x < xSize; x++) values[Layout::template index<xSize, ySize>(x, y)] = column[x];
+        Revision::changed();
         return true;
     }
 
+    /**
+     * Set Plane.
+     * Replaces every table value.
+     * @param data the table values, the y values of each x index in turn.
+     * @param count number of values, xSize * ySize.
+     * @returns True if the values were set successfully, False otherwise.
+     */
+    bool setPlane(const T* data, const unsigned int count){
+        if(count != xSize * ySize){
+            return false;
+        }
+        if(Layout::contiguous){
+            memcpy(values, data, xSize * ySize * sizeof(T));
+        }else{
+            for(unsigned int x = 0; x < xSize; x++){
+                for(unsigned int y = 0; y < ySize; y++) values[Layout::template index<xSize, ySize>(x, y)] = data[x * ySize + y];
+            }
+        }
+        Revision::changed();
+        return true;
+    }
+
+    /**
+     * Fill.
+     * Sets every table value, the axes are unchanged.
+     * @param value to set.
+     */
+    void fill(const T value){
+        for(auto& e : values) e = value;
+        Revision::changed();
+    }
+
     /**
      * Load table data from a buffer.
+     * The buffer holds an image written by saveData, see TableImage.h. The header, dimensions,
+     * types and crc are checked before the table is changed. Images written on a target with
+     * the other byte order are swapped.
      * @param buffer pointer to the data buffer.
      * @param size size of the buffer in bytes.
      * @returns true if data was loaded successfully.
      */
     bool loadData(const char* buffer, unsigned int size) {
-        if (size != getSize()) {
+        const unsigned char* image = reinterpret_cast<const unsigned char*>(buffer);
+        bool swapped = false;
+        if (!Image::check(image, size, swapped)) {
             return false;
         }
-        
-        // Copy the table values to the  buffer
-        for (unsigned int i = 0; i < xSize*ySize; i++) {
-            values[i] = buffer[i];
-        }
 
-        // Copy the X values to the  buffer
-        for (unsigned int i = 0; i < xSize; i++) {
-            axisX[i] = buffer[i+getDataSize()];
+        // Copy the table values from the buffer
+        if (Layout::contiguous) {
+            memcpy(values, image + Image::valuesOffset(), xSize * ySize * sizeof(T));
+        } else {
+            for (unsigned int x = 0; x < xSize; x++) {
+                for (unsigned int y = 0; y < ySize; y++) {
+                    memcpy(&values[Layout::template index<xSize, ySize>(x, y)], image + Image::valuesOffset() + (x * ySize + y) * sizeof(T), sizeof(T));
+                }
+            }
         }
 
-        // Copy the Y values to the  buffer
-        for (unsigned int i = 0; i < ySize; i++) {
-            axisY[i] = buffer[i+getDataSize()+getXAxisDataSize()];
+        // Copy the X and Y values from the buffer
+        memcpy(axisX, image + Image::xAxisOffset(), sizeof(axisX));
+        memcpy(axisY, image + Image::yAxisOffset(), sizeof(axisY));
+
+        if (swapped) {
+            TableImageFormat::swapBytes(values, sizeof(T), sizeof(values) / sizeof(T));
+            TableImageFormat::swapBytes(axisX, sizeof(XAxisT), xSize);
+            TableImageFormat::swapBytes(axisY, sizeof(YAxisT), ySize);
         }
         
         // Reset cache
-        cacheIsValid = false;
+        xSpacing = detectSpacing(axisX, xSize);
+        ySpacing = detectSpacing(axisY, ySize);
+        xIndex.build(axisX);
+        yIndex.build(axisY);
+        Revision::changed();
         return true;
     }
 
     /**
      * Save table data to a buffer.
-     * @param buffer pointer to the output buffer. 
-     *               1. Data values
-     *               2. X Axis values
-     *               3. Y Axis values
-     * @param size size of the buffer in bytes.
+     * @param buffer pointer to the output buffer, an image as described in TableImage.h.
+     *               1. Header
+     *               2. Data values
+     *               3. X Axis values
+     *               4. Y Axis values
+     *               5. CRC-32
+     * @param size size of the buffer in bytes, getSize().
      * @returns true if data was saved successfully.
      */
     bool saveData(char* buffer, unsigned int size) const {
         if (size != getSize()) {
             return false;
         }
-        
-        // Copy the table values to the  buffer
-        for (unsigned int i = 0; i < xSize*ySize; i++) {
-            buffer[i] = values[i];
-        }
+        unsigned char* image = reinterpret_cast<unsigned char*>(buffer);
+        Image::writeHeader(image);
 
-        // Copy the X values to the  buffer
-        for (unsigned int i = 0; i < xSize; i++) {
-            buffer[i+getDataSize()] = axisX[i];
+        // Copy the table values to the buffer
+        if (Layout::contiguous) {
+            memcpy(image + Image::valuesOffset(), values, xSize * ySize * sizeof(T));
+        } else {
+            for (unsigned int x = 0; x < xSize; x++) {
+                for (unsigned int y = 0; y < ySize; y++) {
+                    memcpy(image + Image::valuesOffset() + (x * ySize + y) * sizeof(T), &values[Layout::template index<xSize, ySize>(x, y)], sizeof(T));
+                }
+            }
         }
 
-        // Copy the Y values to the  buffer
-        for (unsigned int i = 0; i < ySize; i++) {
-            buffer[i+getDataSize()+getXAxisDataSize()] = axisY[i];
-        }
-        
+        // Copy the X and Y values to the buffer
+        memcpy(image + Image::xAxisOffset(), axisX, sizeof(axisX));
+        memcpy(image + Image::yAxisOffset(), axisY, sizeof(axisY));
+
+        Image::writeCrc(image);
         return true;
     }
 
@@ -344,59 +984,608 @@ public:
         for(auto& e : values) e = 0;
         for(auto& e : axisX) e = 0;
         for(auto& e : axisY) e = 0;
+        xSpacing = AxisSpacing();
+        ySpacing = AxisSpacing();
+        xIndex.build(axisX);
+        yIndex.build(axisY);
+        Revision::changed();
     }
 
     /**
      * Invalidate the cache.
-     * This will force a recalculation of the output when it is next requested.
+     * This will force a recalculation of the output when it is next requested,
+     * by this table and by every lookup context used with it.
      */
     void invalidateCache(){
-        cacheIsValid = false;
+        Revision::changed();
+    }
+
+    /**
+     * Build Axis Indexes.
+     * Rebuilds the axis look up tables left out of date by setXAxisValueByIndex and
+     * setYAxisValueByIndex. Call it after the edits when the table is then only read
+     * through const lookups, which search an axis while its index is out of date.
+     */
+    void buildAxisIndexes(){
+        if(!xIndex.ready()) xIndex.build(axisX);
+        if(!yIndex.ready()) yIndex.build(axisY);
+    }
+
+    /**
+     * Is X Axis Uniform.
+     * @return true if the x-axis breakpoints are evenly spaced and the cell index is computed directly.
+     */
+    bool isXAxisUniform() const {
+        return xSpacing.uniform;
+    }
+
+    /**
+     * Is Y Axis Uniform.
+     * @return true if the y-axis breakpoints are evenly spaced and the cell index is computed directly.
+     */
+    bool isYAxisUniform() const {
+        return ySpacing.uniform;
+    }
+
+    /**
+     * Get Result Cache Hits.
+     * @return number of lookups answered with a cached result.
+     */
+    unsigned long getResultCacheHits() const {
+        return cache.getResultCacheHits();
+    }
+
+    /**
+     * Get Bracket Cache Hits.
+     * @return number of lookups whose cell was found at, or next to, the previous cell.
+     */
+    unsigned long getBracketCacheHits() const {
+        return cache.getBracketCacheHits();
+    }
+
+    /**
+     * Get Bracket Cache Misses.
+     * @return number of lookups which required a full search of an axis.
+     */
+    unsigned long getBracketCacheMisses() const {
+        return cache.getBracketCacheMisses();
+    }
+
+    /**
+     * Reset the result and bracket cache hit and miss counters.
+     */
+    void resetBracketCacheStats(){
+        cache.resetStats();
+    }
+
+    /**
+     * Get Stats.
+     * @return a copy of the instrumentation counters, all zero when the Stats policy is TableNoStats.
+     */
+    TableStatsSnapshot getStats() const {
+        return Stats::snapshot();
+    }
+
+    /**
+     * Reset the instrumentation counters.
+     */
+    void resetStats(){
+        Stats::reset();
     }
 
     /**
      * Get Size.
-     * @return size of the table in bytes.
+     * @return size of the saved table image in bytes.
      */
     static constexpr unsigned int getSize(){
-        return getDataSize() + getXAxisDataSize() + getYAxisDataSize();
+        return Image::size();
     }
 
 protected:
     // table values.
-    T values[xSize*ySize*sizeof(T)] = {0};
-    XAxisT axisX[xSize*sizeof(XAxisT)] = {0};
-    YAxisT axisY[ySize*sizeof(YAxisT)] = {0};
+    T values[Layout::template size<xSize, ySize>()] = {0};
+    XAxisT axisX[xSize] = {0};
+    YAxisT axisY[ySize] = {0};
     
 private:
-    // caching.
-    XAxisT lastX_in;
-    YAxisT lastY_in;
-    double lastOutput;
-    bool cacheIsValid;
+    // binary image format of loadData and saveData.
+    typedef TableImage<T, xSize, ySize, XAxisT, YAxisT> Image;
+
+    // number of samples of the batch lookups between choices of the search.
+    static constexpr unsigned int batchBlockSize = 32;
+
+    // spacing of an evenly spaced axis.
+    struct AxisSpacing {
+        uint32_t reciprocal = 0;    // ceil(2^32 / step), when it is not a power of two.
+        uint8_t shift = 0;          // log2 of the step, when it is a power of two.
+        bool uniform = false;
+        bool powerOfTwo = false;
+    };
+
+    // edit count of the table, and the axis look up tables built when an axis is set.
+    typedef TableRevision<(CacheSize > 0)> Revision;
+    using TableAxisIndexes<Index, XAxisT, xSize, YAxisT, ySize>::xIndex;
+    using TableAxisIndexes<Index, XAxisT, xSize, YAxisT, ySize>::yIndex;
+
+    // caching, the lookup state of the non-const getValue.
+    LookupContext cache;
+    // axis spacing, detected when an axis is set.
+    AxisSpacing xSpacing;
+    AxisSpacing ySpacing;
+
+    /**
+     * Find Segment.
+     * Branchless binary search for the axis segment containing the input.
+     * The axis must be sorted ascending and the input within its bounds.
+     * @param axis pointer to the axis values.
+     * @param size number of axis values.
+     * @param in the axis input value.
+     * @return index i of the lower breakpoint, such that axis[i] <= in <= axis[i+1].
+     */
+    template<typename AxisT>
+    static unsigned int findSegment(const AxisT* axis, const unsigned int size, const AxisT in){
+        unsigned int lo = 0;
+        unsigned int n = size - 1;
+        while(n > 1){
+            unsigned int half = n / 2;
+            lo = (axis[lo + half] <= in) ? lo + half : lo;
+            n -= half;
+        }
+        return lo;
+    }
+
+    /**
+     * Search Depth.
+     * @param size number of axis values.
+     * @return number of axis probes of the binary search, which is the same for every input.
+     */
+    static constexpr unsigned int searchDepth(const unsigned int size){
+        return size > 2 ? 1 + searchDepth(size - (size - 1) / 2) : 0;
+    }
+
+    /**
+     * Find Segment.
+     * Uses the direct index of an evenly spaced axis, otherwise a binary search.
+     * @param axis pointer to the axis values.
+     * @param size number of axis values.
+     * @param spacing the detected spacing of the axis.
+     * @param in the axis input value, within the axis bounds.
+     * @return index i of the lower breakpoint, such that axis[i] <= in <= axis[i+1].
+     */
+    template<typename AxisT>
+    static unsigned int findSegment(const AxisT* axis, const unsigned int size, const AxisSpacing& spacing, const AxisT in){
+        if(spacing.uniform){
+            return findSegmentUniform(axis, size, spacing, in);
+        }
+        return findSegment(axis, size, in);
+    }
+
+    /**
+     * Find Segment Near.
+     * Checks the previous segment and its neighbours before falling back to a full search.
+     * @param axis pointer to the axis values.
+     * @param size number of axis values.
+     * @param in the axis input value.
+     * @param idx the previous segment index, updated with the found segment index.
+     * @return true if the segment was found without a full search.
+     */
+    template<typename AxisT>
+    static bool findSegmentNear(const AxisT* axis, const unsigned int size, const AxisT in, unsigned int& idx){
+        if(size < 2){
+            idx = 0;
+            return true;
+        }
+        if(in < axis[idx]){
+            if(idx > 0 && in >= axis[idx-1]){
+                idx--;
+                return true;
+            }
+        }else if(in > axis[idx+1]){
+            if(idx+2 < size && in <= axis[idx+2]){
+                idx++;
+                return true;
+            }
+        }else{
+            return true;
+        }
+        idx = findSegment(axis, size, in);
+        return false;
+    }
+
+    /**
+     * Find Segment Uniform.
+     * Computes the segment of an evenly spaced axis with a shift or a reciprocal multiply.
+     * @param axis pointer to the axis values.
+     * @param size number of axis values.
+     * @param spacing the detected spacing of the axis.
+     * @param in the axis input value, within the axis bounds.
+     * @return index i of the lower breakpoint, such that axis[i] <= in <= axis[i+1].
+     */
+    template<typename AxisT>
+    static unsigned int findSegmentUniform(const AxisT* axis, const unsigned int size, const AxisSpacing& spacing, const AxisT in){
+        unsigned long offset = static_cast<unsigned long>(in - axis[0]);
+        unsigned int idx;
+        if(spacing.powerOfTwo){
+            idx = offset >> spacing.shift;
+        }else{
+            idx = static_cast<unsigned int>((static_cast<unsigned long long>(offset) * spacing.reciprocal) >> 32);
+        }
+        // The last breakpoint belongs to the last segment, and the rounded up
+        // reciprocal may place the input one segment high
+        if(idx > size - 2) idx = size - 2;
+        if(in < axis[idx]) idx--;
+        return idx;
+    }
+
+    /**
+     * Find Segment Fast.
+     * Uses the direct index of an evenly spaced axis, otherwise searches from the previous segment.
+     * @param axis pointer to the axis values.
+     * @param size number of axis values.
+     * @param spacing the detected spacing of the axis.
+     * @param in the axis input value.
+     * @param idx the previous segment index, updated with the found segment index.
+     * @return true if the segment was found without a full search.
+     */
+    template<typename AxisT>
+    static bool findSegmentFast(const AxisT* axis, const unsigned int size, const AxisSpacing& spacing, const AxisT in, unsigned int& idx){
+        if(spacing.uniform){
+            idx = findSegmentUniform(axis, size, spacing, in);
+            return true;
+        }
+        return findSegmentNear(axis, size, in, idx);
+    }
+
+    /**
+     * Find Segment.
+     * Uses the look up table of the axis when the Index has one, otherwise findSegment.
+     * @param axis pointer to the axis values.
+     * @param size number of axis values.
+     * @param spacing the detected spacing of the axis.
+     * @param index the look up table of the axis.
+     * @param in the axis input value, within the axis bounds.
+     * @return index i of the lower breakpoint, such that axis[i] <= in <= axis[i+1].
+     */
+    template<typename AxisT, typename AxisIndex>
+    static unsigned int findSegment(const AxisT* axis, const unsigned int size, const AxisSpacing& spacing, const AxisIndex& index, const AxisT in){
+        if(Index::enabled && index.ready()){
+            return index.find(axis, in);
+        }
+        return findSegment(axis, size, spacing, in);
+    }
+
+    /**
+     * Find Segment Fast.
+     * Uses the look up table of the axis when the Index has one, otherwise findSegmentFast.
+     * @param axis pointer to the axis values.
+     * @param size number of axis values.
+     * @param spacing the detected spacing of the axis.
+     * @param index the look up table of the axis.
+     * @param in the axis input value.
+     * @param idx the previous segment index, updated with the found segment index.
+     * @return true if the segment was found without a full search.
+     */
+    template<typename AxisT, typename AxisIndex>
+    static bool findSegmentFast(const AxisT* axis, const unsigned int size, const AxisSpacing& spacing, const AxisIndex& index, const AxisT in, unsigned int& idx){
+        if(Index::enabled && index.ready()){
+            idx = index.find(axis, in);
+            return true;
+        }
+        return findSegmentFast(axis, size, spacing, in, idx);
+    }
+
+    /**
+     * Find Segment Batch.
+     * Keeps the previous segment when it still contains the input, otherwise uses findSegment.
+     * Both branches are well predicted on slowly moving inputs and on random inputs alike.
+     * @param axis pointer to the axis values.
+     * @param size number of axis values.
+     * @param spacing the detected spacing of the axis.
+     * @param index the look up table of the axis.
+     * @param in the axis input value, within the axis bounds.
+     * @param idx the previous segment index, updated with the found segment index.
+     */
+    template<typename AxisT, typename AxisIndex>
+    static void findSegmentBatch(const AxisT* axis, const unsigned int size, const AxisSpacing& spacing, const AxisIndex& index, const AxisT in, unsigned int& idx){
+        // One branch on both bounds, each bound alone is a coin toss on random inputs
+        if(size > 1 && ((in >= axis[idx]) & (in <= axis[idx+1]))){
+            return;
+        }
+        idx = findSegment(axis, size, spacing, index, in);
+    }
+
+    /**
+     * Segment Weight.
+     * Position of the input within its segment, as a fraction with FracBits fractional bits.
+     * @param axis pointer to the axis values.
+     * @param size number of axis values.
+     * @param spacing the detected spacing of the axis.
+     * @param idx the segment index.
+     * @param in the axis input value, within the segment.
+     * @return the weight of the upper breakpoint, 0 to 2^FracBits.
+     */
+    template<unsigned int FracBits, typename AccT, typename AxisT>
+    static AccT segmentWeight(const AxisT* axis, const unsigned int size, const AxisSpacing& spacing, const unsigned int idx, const AxisT in){
+        if(size < 2){
+            return 0;
+        }
+        const unsigned long d = static_cast<unsigned long>(in - axis[idx]);
+        if(spacing.powerOfTwo){
+            return FracBits >= spacing.shift ? static_cast<AccT>(d) << (FracBits - spacing.shift) : static_cast<AccT>(d >> (spacing.shift - FracBits));
+        }
+        if(spacing.uniform){
+            // The rounded up reciprocal may overshoot by one
+            const AccT one = static_cast<AccT>(1) << FracBits;
+            const AccT w = static_cast<AccT>(((static_cast<unsigned long long>(d) << FracBits) * spacing.reciprocal) >> 32);
+            return w > one ? one : w;
+        }
+        return (static_cast<AccT>(d) << FracBits) / static_cast<AccT>(axis[idx+1] - axis[idx]);
+    }
+
+    /**
+     * Is Ascending.
+     * @param axis pointer to the axis values.
+     * @param size number of axis values.
+     * @return true if every breakpoint is greater than the one before it.
+     */
+    template<typename AxisT>
+    static bool isAscending(const AxisT* axis, const unsigned int size){
+        for (unsigned int i = 1; i < size; i++){
+            if(!(axis[i] > axis[i-1])) return false;
+        }
+        return true;
+    }
+
+    /**
+     * Detect Spacing.
+     * @param axis pointer to the axis values.
+     * @param size number of axis values.
+     * @return the spacing of the axis, uniform if every breakpoint is the same positive step apart.
+     */
+    template<typename AxisT>
+    static TABLE_CONSTEXPR14 AxisSpacing detectSpacing(const AxisT* axis, const unsigned int size){
+        AxisSpacing spacing;
+        // The shift and reciprocal index integer offsets, floating point axes are searched
+        if(size < 2 || axis[1] <= axis[0] || static_cast<AxisT>(1) / 2 != 0){
+            return spacing;
+        }
+        AxisT step = axis[1] - axis[0];
+        for (unsigned int i = 2; i < size; i++){
+            if(axis[i] <= axis[i-1] || static_cast<AxisT>(axis[i] - axis[i-1]) != step) return spacing;
+        }
+        unsigned long long s = static_cast<unsigned long long>(step);
+        spacing.uniform = true;
+        if((s & (s - 1)) == 0){
+            spacing.powerOfTwo = true;
+            while((1ULL << spacing.shift) < s) spacing.shift++;
+        }else{
+            spacing.reciprocal = static_cast<uint32_t>((4294967296ULL + s - 1) / s);
+        }
+        return spacing;
+    }
+
+    /**
+     * Interpolate.
+     * Computes the table value of an input from the cell containing it.
+     * @param cells pointer to the table values, in this table's layout.
+     * @param xAxis pointer to the x-axis values.
+     * @param yAxis pointer to the y-axis values.
+     * @param X_in The x-axis value.
+     * @param Y_in The y-axis value.
+     * @param xMinIdx the x-axis segment containing X_in.
+     * @param yMinIdx the y-axis segment containing Y_in.
+     * @param stats counts the interpolation path taken.
+     * @returns The table value.
+     */
+    static ComputeT interpolate(const T* cells, const XAxisT* xAxis, const YAxisT* yAxis, const XAxisT X_in, const YAxisT Y_in, const unsigned int xMinIdx, const unsigned int yMinIdx, const Stats& stats) {
+        unsigned int xMaxIdx = xSize > 1 ? xMinIdx + 1 : xMinIdx;
+        unsigned int yMaxIdx = ySize > 1 ? yMinIdx + 1 : yMinIdx;
+        XAxisT xMin = xAxis[xMinIdx];
+        XAxisT xMax = xAxis[xMaxIdx];
+        YAxisT yMin = yAxis[yMinIdx];
+        YAxisT yMax = yAxis[yMaxIdx];
+
+        // Direct cell found, return the value
+        if ((X_in == xMin || X_in == xMax) && (Y_in == yMin || Y_in == yMax)){
+            stats.exactHit();
+            return cells[Layout::template index<xSize, ySize>(X_in == xMin ? xMinIdx : xMaxIdx, Y_in == yMin ? yMinIdx : yMaxIdx)];
+        }
+
+        // Interpolation is required
+        ComputeT Q11 = cells[Layout::template index<xSize, ySize>(xMinIdx, yMinIdx)];
+        ComputeT Q12 = cells[Layout::template index<xSize, ySize>(xMinIdx, yMaxIdx)];
+        ComputeT Q21 = cells[Layout::template index<xSize, ySize>(xMaxIdx, yMinIdx)];
+        ComputeT Q22 = cells[Layout::template index<xSize, ySize>(xMaxIdx, yMaxIdx)];
+
+        if(Q11 == Q12 && Q21 == Q22){
+            // 2d interpolation in a (x, 1) sized table
+            stats.linear();
+            return linearInterpolation(Q11, Q21, xMin, xMax, X_in);
+        }else if(Q11 == Q21 && Q12 == Q22){
+            // 2d interpolation in a (1, y) sized table
+            stats.linear();
+            return linearInterpolation(Q11, Q12, yMin, yMax, Y_in);
+        }
+        // 3d interpolation
+        stats.bilinear();
+        return biLinearInterpolation(Q11, Q12, Q21, Q22, xMin, xMax, yMin, yMax, X_in, Y_in);
+    }
 
     /**
-     * Get the Data size.
-     * @return size of the table data in bytes.
+     * Gradient.
+     * Computes the table value and its partial derivatives from the cell containing the input.
+     * @param X_in The x-axis value.
+     * @param Y_in The y-axis value.
+     * @param xMinIdx the x-axis segment containing X_in, moved to the cell above a breakpoint.
+     * @param yMinIdx the y-axis segment containing Y_in, moved to the cell above a breakpoint.
+     * @param dX set to dV/dX.
+     * @param dY set to dV/dY.
+     * @returns The table value.
      */
-    static constexpr unsigned int getDataSize(){
-        return xSize*ySize*sizeof(T);
+    ComputeT gradient(const XAxisT X_in, const YAxisT Y_in, unsigned int& xMinIdx, unsigned int& yMinIdx, ComputeT& dX, ComputeT& dY) const {
+        if(xSize > 2 && xMinIdx + 2 < xSize && X_in == axisX[xMinIdx + 1]) xMinIdx++;
+        if(ySize > 2 && yMinIdx + 2 < ySize && Y_in == axisY[yMinIdx + 1]) yMinIdx++;
+        const unsigned int xMaxIdx = xSize > 1 ? xMinIdx + 1 : xMinIdx;
+        const unsigned int yMaxIdx = ySize > 1 ? yMinIdx + 1 : yMinIdx;
+        const ComputeT q11 = getValueByIndex(xMinIdx, yMinIdx);
+        const ComputeT q12 = getValueByIndex(xMinIdx, yMaxIdx);
+        const ComputeT q21 = getValueByIndex(xMaxIdx, yMinIdx);
+        const ComputeT q22 = getValueByIndex(xMaxIdx, yMaxIdx);
+        const ComputeT xWidth = static_cast<ComputeT>(axisX[xMaxIdx] - axisX[xMinIdx]);
+        const ComputeT yWidth = static_cast<ComputeT>(axisY[yMaxIdx] - axisY[yMinIdx]);
+        const ComputeT fx = xMaxIdx != xMinIdx ? static_cast<ComputeT>(X_in - axisX[xMinIdx]) / xWidth : 0;
+        const ComputeT fy = yMaxIdx != yMinIdx ? static_cast<ComputeT>(Y_in - axisY[yMinIdx]) / yWidth : 0;
+
+        // Slopes of the cell edges, blended by the position in the other axis
+        const ComputeT r1 = q11 + (q21 - q11) * fx;
+        const ComputeT r2 = q12 + (q22 - q12) * fx;
+        dX = xMaxIdx != xMinIdx ? ((q21 - q11) + ((q22 - q12) - (q21 - q11)) * fy) / xWidth : 0;
+        dY = yMaxIdx != yMinIdx ? (r2 - r1) / yWidth : 0;
+        return r1 + (r2 - r1) * fy;
+    }
+
+    /**
+     * Solve Axis.
+     * Inverse lookup along one axis, over the values interpolated between two lines of the other axis.
+     * @param axis pointer to the axis values.
+     * @param size number of axis values.
+     * @param cell the table value at index i of the axis and index j of the other axis.
+     * @param j0 the lower line of the other axis.
+     * @param j1 the upper line of the other axis.
+     * @param f the weight of the upper line.
+     * @param target the table value.
+     * @param out set to the axis value.
+     * @return false if the values are not monotonic or the target is not within them.
+     */
+    template<typename AxisT, typename Cell>
+    static bool solveAxis(const AxisT* axis, const unsigned int size, const Cell& cell, const unsigned int j0, const unsigned int j1,
+                          const ComputeT f, const ComputeT target, ComputeT& out){
+        // The blend of two lines rising (or falling) together rises (or falls), only the lines used are checked
+        const bool lower = f < 1;
+        const bool upper = f > 0 && j1 != j0;
+        bool rising = true;
+        bool falling = true;
+        for (unsigned int i = 1; i < size; i++){
+            if(lower){
+                rising = rising && !(cell(i, j0) < cell(i-1, j0));
+                falling = falling && !(cell(i, j0) > cell(i-1, j0));
+            }
+            if(upper){
+                rising = rising && !(cell(i, j1) < cell(i-1, j1));
+                falling = falling && !(cell(i, j1) > cell(i-1, j1));
+            }
+        }
+        if(!rising && !falling){
+            return false;
+        }
+        // Values along the axis, negated when falling so the search is over rising values
+        const ComputeT sign = rising ? 1 : -1;
+        auto value = [&](const unsigned int i){
+            const ComputeT v0 = cell(i, j0);
+            return sign * (v0 + (static_cast<ComputeT>(cell(i, j1)) - v0) * f);
+        };
+        const ComputeT t = sign * target;
+        if(t < value(0) || t > value(size-1)){
+            return false;
+        }
+        if(size < 2){
+            out = axis[0];
+            return true;
+        }
+        unsigned int lo = 0;
+        unsigned int n = size - 1;
+        while(n > 1){
+            unsigned int half = n / 2;
+            lo = (value(lo + half) < t) ? lo + half : lo;
+            n -= half;
+        }
+        // value(lo) < t <= value(lo + 1), or t == value(0)
+        const ComputeT v0 = value(lo);
+        const ComputeT v1 = value(lo + 1);
+        out = v1 != v0 ? axis[lo] + (t - v0) * static_cast<ComputeT>(axis[lo + 1] - axis[lo]) / (v1 - v0) : static_cast<ComputeT>(axis[lo]);
+        return true;
     }
 
     /**
-     * Get the X Axis size.
-     * @return size of the x axis data in bytes.
+     * Batch lookup.
+     * While most samples stay in the cell of the previous one, as a sensor log does, that cell
+     * is checked first. Otherwise each sample is found by the branchless binary search, so the
+     * searches do not wait on each other. Each sample is interpolated in place. The
+     * reciprocal width of each segment is computed the first time a sample falls in it, so a
+     * batch divides at most once per segment rather than twice per sample.
+     * @param X_in array of x-axis values.
+     * @param Y_in array of y-axis values.
+     * @param yStride step between y-axis values, 0 to use a single y-axis value.
+     * @param out array receiving the table values.
+     * @param count number of values.
      */
-    static constexpr unsigned int getXAxisDataSize(){
-        return xSize*sizeof(XAxisT);
+    void getValuesStrided(const XAxisT* X_in, const YAxisT* Y_in, const unsigned int yStride, ComputeT* out, const unsigned int count) const {
+        // 0 until the reciprocal of the segment is computed
+        ComputeT xReciprocal[xSize] = {0};
+        ComputeT yReciprocal[ySize] = {0};
+        unsigned int xMinIdx = cache.lastXIdx;
+        unsigned int yMinIdx = cache.lastYIdx;
+        bool near = true;
+        for (unsigned int start = 0; start < count; start += batchBlockSize){
+            const unsigned int end = count - start < batchBlockSize ? count : start + batchBlockSize;
+            unsigned int kept = 0;
+            for (unsigned int i = start; i < end; i++){
+                const XAxisT x = X_in[i];
+                const YAxisT y = Y_in[i * yStride];
+                if(x > axisX[xSize-1] || y > axisY[ySize-1] || x < axisX[0] || y < axisY[0]){
+                    out[i] = -1;
+                    continue;
+                }
+                const unsigned int xLastIdx = xMinIdx;
+                const unsigned int yLastIdx = yMinIdx;
+                if(near){
+                    findSegmentBatch(axisX, xSize, xSpacing, xIndex, x, xMinIdx);
+                    findSegmentBatch(axisY, ySize, ySpacing, yIndex, y, yMinIdx);
+                }else{
+                    xMinIdx = findSegment(axisX, xSize, xSpacing, xIndex, x);
+                    yMinIdx = findSegment(axisY, ySize, ySpacing, yIndex, y);
+                }
+                kept += (xMinIdx == xLastIdx) & (yMinIdx == yLastIdx);
+                const unsigned int xMaxIdx = xSize > 1 ? xMinIdx + 1 : xMinIdx;
+                const unsigned int yMaxIdx = ySize > 1 ? yMinIdx + 1 : yMinIdx;
+                if(xReciprocal[xMinIdx] == 0 && xMaxIdx != xMinIdx){
+                    xReciprocal[xMinIdx] = static_cast<ComputeT>(1) / static_cast<ComputeT>(axisX[xMaxIdx] - axisX[xMinIdx]);
+                }
+                if(yReciprocal[yMinIdx] == 0 && yMaxIdx != yMinIdx){
+                    yReciprocal[yMinIdx] = static_cast<ComputeT>(1) / static_cast<ComputeT>(axisY[yMaxIdx] - axisY[yMinIdx]);
+                }
+                const ComputeT fx = static_cast<ComputeT>(x - axisX[xMinIdx]) * xReciprocal[xMinIdx];
+                const ComputeT fy = static_cast<ComputeT>(y - axisY[yMinIdx]) * yReciprocal[yMinIdx];
+                const ComputeT q11 = getValueByIndex(xMinIdx, yMinIdx);
+                const ComputeT q12 = getValueByIndex(xMinIdx, yMaxIdx);
+                const ComputeT q21 = getValueByIndex(xMaxIdx, yMinIdx);
+                const ComputeT q22 = getValueByIndex(xMaxIdx, yMaxIdx);
+                const ComputeT r1 = q11 + (q21 - q11) * fx;
+                const ComputeT r2 = q12 + (q22 - q12) * fx;
+                out[i] = r1 + (r2 - r1) * fy;
+            }
+            // Keep the previous cell while most samples stay in it, otherwise search each sample
+            // independently, so the searches of neighbouring samples overlap
+            near = kept * 2 >= end - start;
+        }
     }
 
     /**
-     * Get the Y Axis size.
-     * @return size of the y axis data in bytes.
+     * Find Index.
+     * @param axis pointer to the axis values.
+     * @param size number of axis values.
+     * @param in the axis input value.
+     * @return index of the breakpoint equal to the input. -1 if there is none.
      */
-    static constexpr unsigned int getYAxisDataSize(){
-        return ySize*sizeof(YAxisT);
+    template<typename AxisT>
+    static int findIndex(const AxisT* axis, const unsigned int size, const AxisT in){
+        if(in < axis[0] || in > axis[size-1]){
+            return -1;
+        }
+        unsigned int i = findSegment(axis, size, in);
+        if(axis[i] == in) return i;
+        if(i+1 < size && axis[i+1] == in) return i+1;
+        return -1;
     }
 
     /** 
@@ -411,15 +1600,16 @@ private:
      *   |__!_____!______!_
      *      x1    x     x2
      */
-    static double biLinearInterpolation(const double q11, const double q12, const double q21, const double q22, const int x1, const int x2, const int y1, const int y2, const int x, const int y) 
+    static ComputeT biLinearInterpolation(const ComputeT q11, const ComputeT q12, const ComputeT q21, const ComputeT q22, const XAxisT x1, const XAxisT x2, const YAxisT y1, const YAxisT y2, const XAxisT x, const YAxisT y) 
     {
-        int x2x1 = x2 - x1;
-        int y2y1 = y2 - y1;
-        int x2x = x2 - x;
-        int y2y = y2 - y;
-        int yy1 = y - y1;
-        int xx1 = x - x1;
-        return 1.0 / (x2x1 * y2y1) * (
+        // Offsets in the axis types, so floating point axes are not truncated
+        const ComputeT x2x1 = static_cast<ComputeT>(x2 - x1);
+        const ComputeT y2y1 = static_cast<ComputeT>(y2 - y1);
+        const ComputeT x2x = static_cast<ComputeT>(x2 - x);
+        const ComputeT y2y = static_cast<ComputeT>(y2 - y);
+        const ComputeT yy1 = static_cast<ComputeT>(y - y1);
+        const ComputeT xx1 = static_cast<ComputeT>(x - x1);
+        return static_cast<ComputeT>(1) / (x2x1 * y2y1) * (
             q11 * x2x * y2y +
             q21 * xx1 * y2y +
             q12 * x2x * yy1 +
@@ -434,10 +1624,18 @@ private:
      *   |__!_____!______!_
      *      x1    x     x2
      */
-    static double linearInterpolation(const double q11, const double q21, const int x1,  const int x2, const int x)
+    template<typename AxisT>
+    static ComputeT linearInterpolation(const ComputeT q11, const ComputeT q21, const AxisT x1,  const AxisT x2, const AxisT x)
     {
-        return q11 + ((q21-q11)/(x2-x1)) * (x-x1);
+        return q11 + ((q21-q11)/static_cast<ComputeT>(x2-x1)) * static_cast<ComputeT>(x-x1);
     }
 };
 
+// Without caching a Table is its values and axes, its last cell and the spacing of each axis
+static_assert(sizeof(Table<uint8_t, 16, 16, int, int, double, TableRowMajor, 0>) <= 16 * 16 + 2 * 16 * sizeof(int) + 2 * sizeof(unsigned int) + 2 * 8,
+              "Table overhead must stay fixed and small");
+// A result cache adds the result, its table and revision, the hit counters and the table revision
+static_assert(sizeof(Table<uint8_t, 16, 16>) <= sizeof(Table<uint8_t, 16, 16, int, int, double, TableRowMajor, 0>) + 56,
+              "Table result cache overhead must stay fixed and small");
+
 #endif // EPICECU_TABLE_H
\ No newline at end of file
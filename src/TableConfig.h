@@ -0,0 +1,20 @@
+#ifndef EPICECU_TABLE_CONFIG_H
+#define EPICECU_TABLE_CONFIG_H
+
+/**
+ * Table Config.
+ *
+ * Language feature macros shared by the Table headers.
+ *
+ * Copyright © 2022 David Cedar. All rights reserved.
+ * Licensed under the LGPL License (see LICENSE file)
+ */
+
+// The constexpr constructor needs C++14, with C++11 it is an ordinary constructor.
+#if __cplusplus >= 201402L
+#define TABLE_CONSTEXPR14 constexpr
+#else
+#define TABLE_CONSTEXPR14
+#endif
+
+#endif // EPICECU_TABLE_CONFIG_H
@@ -0,0 +1,194 @@
+#ifndef EPICECU_TABLE_GRID_H
+#define EPICECU_TABLE_GRID_H
+
+/**
+ * Table Grid.
+ *
+ * Evaluates a Table over a dense grid of inputs, for surface plots and smoothness
+ * checks, and resamples a Table onto the breakpoints of another. The segment and
+ * weight of every grid column and row are found once, walking each sorted input
+ * axis from the previous segment, so each grid point is a blend of four corners
+ * with no search. The rows of the grid are split across threads:
+ *
+ *   std::vector<double> surface(1024 * 1024);
+ *   TableGrid::evaluate(fuelMap, rpm, 1024, map, 1024, surface.data());
+ *
+ * For native targets, uses std::thread.
+ *
+ * Copyright © 2022 David Cedar. All rights reserved.
+ * Licensed under the LGPL License (see LICENSE file)
+ */
+
+#include "Table.h"
+
+#include <thread>
+#include <vector>
+
+struct TableGrid {
+    /**
+     * Evaluates a table over a grid.
+     * The results match getValue to within rounding.
+     * @param table the table.
+     * @param X_in the x-axis values of the grid, ascending for the fastest walk.
+     * @param xCount number of x-axis values.
+     * @param Y_in the y-axis values of the grid, ascending for the fastest walk.
+     * @param yCount number of y-axis values.
+     * @param out array of xCount * yCount values receiving the table values, the y values of
+     *            each x-axis value in turn. -1 where out of bounds.
+     * @param threads number of threads, 0 for one per core.
+     */
+    template<typename T, unsigned int xSize, unsigned int ySize, typename XAxisT, typename YAxisT, typename ComputeT,
+             typename Layout, unsigned int CacheSize, typename Stats, typename Index>
+    static void evaluate(const Table<T, xSize, ySize, XAxisT, YAxisT, ComputeT, Layout, CacheSize, Stats, Index>& table,
+                         const XAxisT* X_in, const unsigned int xCount, const YAxisT* Y_in, const unsigned int yCount,
+                         ComputeT* out, const unsigned int threads = 0) {
+        std::vector<Weight<ComputeT>> xWeights(xCount);
+        std::vector<Weight<ComputeT>> yWeights(yCount);
+        locate(table, table.axisX, xSize, X_in, xCount, xWeights.data());
+        locate(table, table.axisY, ySize, Y_in, yCount, yWeights.data());
+
+        parallelRows(xCount, threads, [&](const unsigned int x0, const unsigned int x1) {
+            for (unsigned int i = x0; i < x1; i++) {
+                const Weight<ComputeT>& wx = xWeights[i];
+                ComputeT* row = out + static_cast<unsigned long>(i) * yCount;
+                for (unsigned int j = 0; j < yCount; j++) {
+                    const Weight<ComputeT>& wy = yWeights[j];
+                    if (!wx.valid || !wy.valid) {
+                        row[j] = -1;
+                        continue;
+                    }
+                    const ComputeT q11 = table.getValueByIndex(wx.lower, wy.lower);
+                    const ComputeT q12 = table.getValueByIndex(wx.lower, wy.upper);
+                    const ComputeT q21 = table.getValueByIndex(wx.upper, wy.lower);
+                    const ComputeT q22 = table.getValueByIndex(wx.upper, wy.upper);
+                    const ComputeT r1 = q11 + (q21 - q11) * wx.weight;
+                    const ComputeT r2 = q12 + (q22 - q12) * wx.weight;
+                    row[j] = r1 + (r2 - r1) * wy.weight;
+                }
+            }
+        });
+    }
+
+    /**
+     * Evaluates a table over an evenly spaced grid covering its axes.
+     * @param table the table.
+     * @param xCount number of grid points along the x-axis, at least 2.
+     * @param yCount number of grid points along the y-axis, at least 2, or 1 for a (x, 1) table.
+     * @param out array of xCount * yCount values receiving the table values.
+     * @param threads number of threads, 0 for one per core.
+     */
+    template<typename T, unsigned int xSize, unsigned int ySize, typename XAxisT, typename YAxisT, typename ComputeT,
+             typename Layout, unsigned int CacheSize, typename Stats, typename Index>
+    static void evaluate(const Table<T, xSize, ySize, XAxisT, YAxisT, ComputeT, Layout, CacheSize, Stats, Index>& table,
+                         const unsigned int xCount, const unsigned int yCount, ComputeT* out, const unsigned int threads = 0) {
+        std::vector<XAxisT> X_in(xCount);
+        std::vector<YAxisT> Y_in(yCount);
+        span(table.axisX[0], table.axisX[xSize - 1], X_in.data(), xCount);
+        span(table.axisY[0], table.axisY[ySize - 1], Y_in.data(), yCount);
+        evaluate(table, X_in.data(), xCount, Y_in.data(), yCount, out, threads);
+    }
+
+    /**
+     * Resamples a table onto the breakpoints of another.
+     * The axes of the destination are set first, its values are replaced by the source
+     * evaluated at its breakpoints, rounded to the nearest value for integer value types.
+     * @param source the table to resample.
+     * @param destination the table receiving the values, with its axes set.
+     * @param threads number of threads, 0 for one per core.
+     * @returns false if a destination breakpoint is out of the bounds of the source, the destination is unchanged.
+     */
+    template<typename T, unsigned int xSize, unsigned int ySize, typename XAxisT, typename YAxisT, typename ComputeT,
+             typename Layout, unsigned int CacheSize, typename Stats, typename Index,
+             typename DT, unsigned int dxSize, unsigned int dySize, typename DLayout, unsigned int DCacheSize, typename DStats, typename DIndex>
+    static bool resample(const Table<T, xSize, ySize, XAxisT, YAxisT, ComputeT, Layout, CacheSize, Stats, Index>& source,
+                         Table<DT, dxSize, dySize, XAxisT, YAxisT, ComputeT, DLayout, DCacheSize, DStats, DIndex>& destination,
+                         const unsigned int threads = 0) {
+        if (destination.axisX[0] < source.axisX[0] || destination.axisX[dxSize - 1] > source.axisX[xSize - 1] ||
+            destination.axisY[0] < source.axisY[0] || destination.axisY[dySize - 1] > source.axisY[ySize - 1]) {
+            return false;
+        }
+        std::vector<ComputeT> grid(dxSize * dySize);
+        evaluate(source, destination.axisX, dxSize, destination.axisY, dySize, grid.data(), threads);
+        std::vector<DT> plane(dxSize * dySize);
+        for (unsigned int i = 0; i < dxSize * dySize; i++) {
+            plane[i] = round<DT>(grid[i]);
+        }
+        return destination.setPlane(plane.data(), dxSize * dySize);
+    }
+
+private:
+    // segment and weight of a grid column or row.
+    template<typename ComputeT>
+    struct Weight {
+        unsigned int lower = 0;
+        unsigned int upper = 0;
+        ComputeT weight = 0;
+        bool valid = false;
+    };
+
+    /**
+     * Locate.
+     * Finds the segment and weight of each grid input, starting each search at the previous segment.
+     */
+    template<typename TableT, typename AxisT, typename ComputeT>
+    static void locate(const TableT&, const AxisT* axis, const unsigned int size, const AxisT* in, const unsigned int count, Weight<ComputeT>* weights) {
+        unsigned int idx = 0;
+        for (unsigned int i = 0; i < count; i++) {
+            Weight<ComputeT>& w = weights[i];
+            w.valid = !(in[i] < axis[0] || in[i] > axis[size - 1]);
+            if (!w.valid) {
+                continue;
+            }
+            TableT::findSegmentNear(axis, size, in[i], idx);
+            w.lower = idx;
+            w.upper = size > 1 ? idx + 1 : idx;
+            w.weight = w.upper != w.lower ? static_cast<ComputeT>(in[i] - axis[w.lower]) / static_cast<ComputeT>(axis[w.upper] - axis[w.lower]) : 0;
+        }
+    }
+
+    /**
+     * Span.
+     * Fills count evenly spaced values from first to last, rounded down for integer axes.
+     */
+    template<typename AxisT>
+    static void span(const AxisT first, const AxisT last, AxisT* out, const unsigned int count) {
+        for (unsigned int i = 0; i < count; i++) {
+            out[i] = count > 1 ? static_cast<AxisT>(first + (static_cast<double>(last) - first) * i / (count - 1)) : first;
+        }
+        if (count > 1) out[count - 1] = last;
+    }
+
+    /**
+     * Round.
+     * @return the value converted to T, rounded to the nearest for integer types.
+     */
+    template<typename T, typename ComputeT>
+    static T round(const ComputeT value) {
+        if (static_cast<T>(1) / 2 == 0) {
+            return static_cast<T>(value < 0 ? value - static_cast<ComputeT>(0.5) : value + static_cast<ComputeT>(0.5));
+        }
+        return static_cast<T>(value);
+    }
+
+    /**
+     * Parallel Rows.
+     * Runs body over [0, rows) split into one contiguous range per thread.
+     */
+    template<typename Body>
+    static void parallelRows(const unsigned int rows, unsigned int threads, const Body& body) {
+        if (threads == 0) threads = std::thread::hardware_concurrency();
+        if (threads == 0) threads = 1;
+        if (threads > rows) threads = rows > 0 ? rows : 1;
+        std::vector<std::thread> pool;
+        const unsigned int chunk = (rows + threads - 1) / threads;
+        for (unsigned int t = 1; t < threads; t++) {
+            const unsigned int x0 = t * chunk;
+            const unsigned int x1 = x0 + chunk < rows ? x0 + chunk : rows;
+            if (x0 < x1) pool.emplace_back([&body, x0, x1]() { body(x0, x1); });
+        }
+        body(0, chunk < rows ? chunk : rows);
+        for (auto& thread : pool) thread.join();
+    }
+};
+
+#endif // EPICECU_TABLE_GRID_H
@@ -0,0 +1,169 @@
+#ifndef EPICECU_TABLE_INDEX_H
+#define EPICECU_TABLE_INDEX_H
+
+/**
+ * Table Index.
+ *
+ * Axis search policies of a Table. TableSearchIndex, the default, finds the
+ * segment of an input with the direct index of an evenly spaced axis, or a
+ * search from the previous segment. TableIndexLut keeps a look up table per axis,
+ * built when the whole axis is set, mapping the input to its segment with one load:
+ *
+ *   lut[(in - axis[0]) >> shift]
+ *
+ * The shift is the smallest which fits the axis range in 2^bits entries. With
+ * 2^bits at least the range the index is dense and exact, e.g. 8 bits for a
+ * uint8_t axis. Fewer bits quantise the input, a bucket holding a breakpoint
+ * then needs a compare or two to step to the segment of the input. Each entry
+ * is 1 byte for axes of up to 256 breakpoints, 2 bytes otherwise, so bits sets
+ * the memory used against the speed, e.g.
+ *
+ *   bits  entries  bytes per axis (size <= 256)
+ *      6       64      64
+ *      8      256     256
+ *     12     4096    4096
+ *
+ * Setting a single breakpoint marks the look up table out of date rather than
+ * rebuilding it, except for the last breakpoint of the axis, so an axis filled
+ * in order is built once. The next non-const lookup, or Table::buildAxisIndexes(),
+ * rebuilds an out of date table. Const lookups skip it and search the axis until then.
+ *
+ * For integer axes only.
+ *
+ * Copyright © 2022 David Cedar. All rights reserved.
+ * Licensed under the LGPL License (see LICENSE file)
+ */
+
+#include "TableConfig.h"
+
+#include <stdint.h>
+
+/**
+ * Segment index type of a look up table entry.
+ */
+template<bool small>
+struct TableIndexEntry {
+    typedef uint8_t type;
+};
+
+template<>
+struct TableIndexEntry<false> {
+    typedef uint16_t type;
+};
+
+/**
+ * Searches the axis, no look up table.
+ */
+struct TableSearchIndex {
+    static constexpr bool enabled = false;
+
+    template<typename AxisT, unsigned int size>
+    struct Axis {
+        TABLE_CONSTEXPR14 void build(const AxisT*) const {}
+        void invalidate() const {}
+        constexpr bool ready() const {
+            return false;
+        }
+        unsigned int find(const AxisT*, const AxisT) const {
+            return 0;
+        }
+    };
+};
+
+/**
+ * Look up table of the segment of each input bucket.
+ * @tparam bits log2 of the number of entries per axis, 1 to 16.
+ */
+template<unsigned int bits = 8>
+struct TableIndexLut {
+    static_assert(bits > 0 && bits <= 16, "bits must be from 1 to 16");
+
+    static constexpr bool enabled = true;
+    static constexpr unsigned long entries = 1UL << bits;
+
+    template<typename AxisT, unsigned int size>
+    struct Axis {
+        static_assert(static_cast<AxisT>(1) / 2 == 0, "TableIndexLut needs an integer axis");
+        static_assert(size <= 65536, "TableIndexLut supports up to 65536 breakpoints");
+
+        // segment index type, a byte when it fits.
+        typedef typename TableIndexEntry<(size <= 256)>::type Entry;
+
+        /**
+         * Builds the look up table of a sorted axis.
+         * @param axis pointer to the axis values.
+         */
+        TABLE_CONSTEXPR14 void build(const AxisT* axis) {
+            const unsigned long range = size > 1 && axis[size - 1] > axis[0] ? static_cast<unsigned long>(axis[size - 1] - axis[0]) : 0;
+            shift = 0;
+            while ((range >> shift) >= entries) shift++;
+            // Each entry is the segment containing the first input of its bucket
+            unsigned int idx = 0;
+            for (unsigned long q = 0; q < entries; q++) {
+                const unsigned long start = q << shift;
+                while (idx + 2 < size && static_cast<unsigned long>(axis[idx + 1] - axis[0]) <= start) idx++;
+                lut[q] = static_cast<Entry>(idx);
+            }
+            built = true;
+        }
+
+        /**
+         * Marks the look up table out of date, after a breakpoint has changed.
+         */
+        void invalidate() {
+            built = false;
+        }
+
+        /**
+         * Ready.
+         * @return true if the look up table is built for the current axis.
+         */
+        constexpr bool ready() const {
+            return built;
+        }
+
+        /**
+         * Find.
+         * @param axis pointer to the axis values, as built.
+         * @param in the axis input value, within the axis bounds.
+         * @return index i of the lower breakpoint, such that axis[i] <= in <= axis[i+1].
+         */
+        unsigned int find(const AxisT* axis, const AxisT in) const {
+            if (size < 2) {
+                return 0;
+            }
+            unsigned int idx = lut[static_cast<unsigned long>(in - axis[0]) >> shift];
+            // Step over the breakpoints within the bucket
+            while (idx + 2 < size && in > axis[idx + 1]) idx++;
+            return idx;
+        }
+
+        Entry lut[entries] = {0};
+        unsigned char shift = 0;
+        bool built = false;
+    };
+};
+
+/**
+ * Index of each axis of a table.
+ * Empty when the index is disabled, so a Table without an index holds no space for it.
+ */
+template<typename Index, typename XAxisT, unsigned int xSize, typename YAxisT, unsigned int ySize, bool enabled = Index::enabled>
+struct TableAxisIndexes {
+    typename Index::template Axis<XAxisT, xSize> xIndex;
+    typename Index::template Axis<YAxisT, ySize> yIndex;
+};
+
+template<typename Index, typename XAxisT, unsigned int xSize, typename YAxisT, unsigned int ySize>
+struct TableAxisIndexes<Index, XAxisT, xSize, YAxisT, ySize, false> {
+    static constexpr typename Index::template Axis<XAxisT, xSize> xIndex{};
+    static constexpr typename Index::template Axis<YAxisT, ySize> yIndex{};
+};
+
+template<typename Index, typename XAxisT, unsigned int xSize, typename YAxisT, unsigned int ySize>
+constexpr typename Index::template Axis<XAxisT, xSize> TableAxisIndexes<Index, XAxisT, xSize, YAxisT, ySize, false>::xIndex;
+
+template<typename Index, typename XAxisT, unsigned int xSize, typename YAxisT, unsigned int ySize>
+constexpr typename Index::template Axis<YAxisT, ySize> TableAxisIndexes<Index, XAxisT, xSize, YAxisT, ySize, false>::yIndex;
+
+#endif // EPICECU_TABLE_INDEX_H
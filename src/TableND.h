@@ -0,0 +1,299 @@
+#ifndef EPICECU_TABLE_ND_H
+#define EPICECU_TABLE_ND_H
+
+/**
+ * N Dimensional Table.
+ *
+ * A Table with any number of axes, each described by a TableAxis, and a single
+ * multilinear interpolation over the 2^N corners of the cell containing the input.
+ * Three axes give trilinear interpolation, e.g. RPM x MAP x coolant temperature:
+ *
+ *   TableND<uint8_t, TableAxis<16>, TableAxis<16>, TableAxis<8, int8_t>> fuel;
+ *   double value = fuel.getValue(2500, 80, 20);
+ *
+ * The values are stored with the last axis varying fastest, as the y values of
+ * each x index in a Table. Table remains the 1D and 2D table.
+ *
+ * Copyright © 2022 David Cedar. All rights reserved.
+ * Licensed under the LGPL License (see LICENSE file)
+ */
+
+#include "Table.h"
+
+/**
+ * Describes an axis of a TableND.
+ * @tparam size number of breakpoints.
+ * @tparam AxisT type of the breakpoints. Integer axes which are evenly spaced are indexed
+ * directly, floating point axes are always searched.
+ */
+template<unsigned int size, typename AxisT = int>
+struct TableAxis {
+    static constexpr unsigned int count = size;
+    typedef AxisT type;
+};
+
+/**
+ * Breakpoints of a list of axes, the first axis and the rest in turn.
+ */
+template<typename... Axes>
+struct TableNDAxes {
+    static constexpr unsigned int cells = 1;
+};
+
+template<typename Axis, typename... Rest>
+struct TableNDAxes<Axis, Rest...> {
+    static constexpr unsigned int cells = Axis::count * TableNDAxes<Rest...>::cells;
+    typename Axis::type values[Axis::count] = {0};
+    TableNDAxes<Rest...> rest;
+};
+
+/**
+ * Access to axis d of a list of axes.
+ */
+template<unsigned int d, typename... Axes>
+struct TableNDAxisAt;
+
+template<typename Axis, typename... Rest>
+struct TableNDAxisAt<0, Axis, Rest...> {
+    typedef Axis type;
+    static typename Axis::type* get(TableNDAxes<Axis, Rest...>& axes){
+        return axes.values;
+    }
+    static const typename Axis::type* get(const TableNDAxes<Axis, Rest...>& axes){
+        return axes.values;
+    }
+};
+
+template<unsigned int d, typename Axis, typename... Rest>
+struct TableNDAxisAt<d, Axis, Rest...> {
+    typedef typename TableNDAxisAt<d - 1, Rest...>::type type;
+    static typename type::type* get(TableNDAxes<Axis, Rest...>& axes){
+        return TableNDAxisAt<d - 1, Rest...>::get(axes.rest);
+    }
+    static const typename type::type* get(const TableNDAxes<Axis, Rest...>& axes){
+        return TableNDAxisAt<d - 1, Rest...>::get(axes.rest);
+    }
+};
+
+template<typename T, typename ComputeT, typename... Axes>
+class BasicTableND {
+    static_assert(sizeof...(Axes) > 0, "A TableND needs at least one axis");
+
+public:
+    // number of axes.
+    static constexpr unsigned int dims = sizeof...(Axes);
+    // number of table values.
+    static constexpr unsigned int cells = TableNDAxes<Axes...>::cells;
+
+    /**
+     * Initialises the Table object.
+     */
+    void initialise() {
+        resetData();
+        for (unsigned int d = 0; d < dims; d++) lastIdx[d] = 0;
+    }
+
+    /**
+     * Gets the table value by axis values, one per axis.
+     * Starts the search of each axis at its previous cell.
+     * @param in the axis values.
+     * @returns The table value. -1 if out of bounds.
+     */
+    ComputeT getValue(const typename Axes::type... in) {
+        ComputeT weights[dims];
+        if (!locate(axes, spacing, lastIdx, weights, true, in...)) {
+            return -1;
+        }
+        return interpolate(lastIdx, weights);
+    }
+
+    /**
+     * Gets the table value by axis values, without the cache.
+     * @param in the axis values.
+     * @returns The table value. -1 if out of bounds.
+     */
+    ComputeT getValue(const typename Axes::type... in) const {
+        unsigned int idx[dims];
+        ComputeT weights[dims];
+        if (!locate(axes, spacing, idx, weights, false, in...)) {
+            return -1;
+        }
+        return interpolate(idx, weights);
+    }
+
+    /**
+     * Set Value by Index.
+     * @param index index of the value on each axis.
+     * @param value to set.
+     * @returns True if the value was set successfully, False otherwise.
+     */
+    bool setValueByIndex(const unsigned int (&index)[dims], const T value) {
+        unsigned int offset = 0;
+        if (!cellOffset(index, offset)) {
+            return false;
+        }
+        values[offset] = value;
+        return true;
+    }
+
+    /**
+     * Get Value by Index.
+     * @param index index of the value on each axis, within the table.
+     * @return value at the index.
+     */
+    T getValueByIndex(const unsigned int (&index)[dims]) const {
+        unsigned int offset = 0;
+        cellOffset(index, offset);
+        return values[offset];
+    }
+
+    /**
+     * Set Axis Value by Index.
+     * @tparam d the axis.
+     * @param i index of the breakpoint on the axis.
+     * @param value to set.
+     * @returns True if the value was set successfully, False otherwise.
+     */
+    template<unsigned int d>
+    bool setAxisValueByIndex(const unsigned int i, const typename TableNDAxisAt<d, Axes...>::type::type value) {
+        typedef typename TableNDAxisAt<d, Axes...>::type Axis;
+        if (i >= Axis::count) {
+            return false;
+        }
+        typename Axis::type* axis = TableNDAxisAt<d, Axes...>::get(axes);
+        axis[i] = value;
+        spacing[d] = Lookup::detectSpacing(axis, Axis::count);
+        return true;
+    }
+
+    /**
+     * Get Axis Value by Index.
+     * @tparam d the axis.
+     * @param i index of the breakpoint on the axis.
+     * @return the breakpoint.
+     */
+    template<unsigned int d>
+    typename TableNDAxisAt<d, Axes...>::type::type getAxisValueByIndex(const unsigned int i) const {
+        return TableNDAxisAt<d, Axes...>::get(axes)[i];
+    }
+
+    /**
+     * Reset the data to zero.
+     */
+    void resetData() {
+        for (auto& e : values) e = 0;
+        axes = TableNDAxes<Axes...>();
+        for (auto& s : spacing) s = AxisSpacing();
+    }
+
+protected:
+    // table values, the last axis varying fastest.
+    T values[cells] = {0};
+    TableNDAxes<Axes...> axes;
+
+private:
+    // the segment search and spacing detection of Table.
+    typedef Table<T, 2, 1, int, int, ComputeT> Lookup;
+    typedef typename Lookup::AxisSpacing AxisSpacing;
+
+    // axis spacing, detected when an axis is set.
+    AxisSpacing spacing[dims];
+    // bracket caching.
+    unsigned int lastIdx[dims] = {0};
+
+    /**
+     * Locate.
+     * Finds the segment of each axis containing its input and the weight of the upper breakpoint.
+     * @param node the axes from the current axis on.
+     * @param spacing the spacing of the current axis on.
+     * @param idx the segment indices from the current axis on, the previous segments when near.
+     * @param weights the weights from the current axis on.
+     * @param near true to start each search at the previous segment.
+     * @param in the input of the current axis.
+     * @param rest the inputs of the following axes.
+     * @return false if an input is out of bounds.
+     */
+    static bool locate(const TableNDAxes<>&, const AxisSpacing*, unsigned int*, ComputeT*, const bool) {
+        return true;
+    }
+
+    template<typename Axis, typename... Rest, typename... Ins>
+    static bool locate(const TableNDAxes<Axis, Rest...>& node, const AxisSpacing* spacing, unsigned int* idx, ComputeT* weights,
+                       const bool near, const typename Axis::type in, const Ins... rest) {
+        const typename Axis::type* axis = node.values;
+        if (in < axis[0] || in > axis[Axis::count - 1]) {
+            return false;
+        }
+        if (Axis::count < 2) {
+            idx[0] = 0;
+            weights[0] = 0;
+        } else {
+            if (near) {
+                Lookup::findSegmentFast(axis, Axis::count, spacing[0], in, idx[0]);
+            } else {
+                idx[0] = Lookup::findSegment(axis, Axis::count, spacing[0], in);
+            }
+            weights[0] = static_cast<ComputeT>(in - axis[idx[0]]) / static_cast<ComputeT>(axis[idx[0] + 1] - axis[idx[0]]);
+        }
+        return locate(node.rest, spacing + 1, idx + 1, weights + 1, near, rest...);
+    }
+
+    /**
+     * Multilinear Interpolation.
+     * Gathers the 2^N corners of the cell, then interpolates along the last axis,
+     * halving the corners, and so on to the first axis.
+     * @param idx the segment of each axis.
+     * @param weights the weight of the upper breakpoint of each axis.
+     * @returns The table value.
+     */
+    ComputeT interpolate(const unsigned int* idx, const ComputeT* weights) const {
+        static const unsigned int sizes[dims] = {Axes::count...};
+        // Corner c takes the upper breakpoint of axis d when bit (dims - 1 - d) is set
+        unsigned int offsets[1u << dims];
+        offsets[0] = 0;
+        for (unsigned int d = 0, n = 1; d < dims; d++, n *= 2) {
+            const unsigned int step = sizes[d] > 1 ? 1 : 0;
+            for (unsigned int j = n; j-- > 0;) {
+                offsets[2 * j] = offsets[j] * sizes[d] + idx[d];
+                offsets[2 * j + 1] = offsets[2 * j] + step;
+            }
+        }
+        ComputeT corners[1u << dims];
+        for (unsigned int c = 0; c < (1u << dims); c++) {
+            corners[c] = values[offsets[c]];
+        }
+        for (unsigned int d = dims, n = 1u << dims; d-- > 0; n /= 2) {
+            for (unsigned int j = 0; j < n / 2; j++) {
+                corners[j] = corners[2 * j] + (corners[2 * j + 1] - corners[2 * j]) * weights[d];
+            }
+        }
+        return corners[0];
+    }
+
+    /**
+     * Cell Offset.
+     * @param index index of the value on each axis.
+     * @param offset set to the position of the value in the table.
+     * @return false if an index is out of bounds.
+     */
+    static bool cellOffset(const unsigned int (&index)[dims], unsigned int& offset) {
+        static const unsigned int sizes[dims] = {Axes::count...};
+        offset = 0;
+        for (unsigned int d = 0; d < dims; d++) {
+            if (index[d] >= sizes[d]) {
+                return false;
+            }
+            offset = offset * sizes[d] + index[d];
+        }
+        return true;
+    }
+};
+
+/**
+ * TableND.
+ * A BasicTableND with the interpolation computed in double.
+ */
+template<typename T, typename... Axes>
+using TableND = BasicTableND<T, double, Axes...>;
+
+#endif // EPICECU_TABLE_ND_H
@@ -0,0 +1,473 @@
+#ifndef EPICECU_TABLE_REPLAY_H
+#define EPICECU_TABLE_REPLAY_H
+
+/**
+ * Table Replay.
+ *
+ * Replays a datalog through tables, to compare a retune with the logged values.
+ * A log is read in batches of samples, one array per column:
+ *
+ *   TableBinaryLog<4>  a packed binary log of Columns values per sample, memory mapped
+ *   TableCsvLog<4>     a CSV log, read in large chunks and parsed in place
+ *
+ * A TableReplayChannel looks up a table over two columns of each batch with
+ * getValues, and keeps the error statistics against a logged column:
+ *
+ *   TableBinaryLog<4> log;
+ *   TableLogBatch<4> batch;
+ *   TableReplayChannel<decltype(fuelMap)> fuel(fuelMap, RPM, MAP, FUEL);
+ *   log.open("track.bin");
+ *   while (log.read(batch) > 0) fuel.process(batch);
+ *
+ * Nothing is allocated per sample or per batch. For native POSIX targets.
+ *
+ * Copyright © 2022 David Cedar. All rights reserved.
+ * Licensed under the LGPL License (see LICENSE file)
+ */
+
+#include "Table.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * A batch of log samples, one array per column.
+ * @tparam Columns number of log columns.
+ * @tparam Capacity number of samples per batch.
+ * @tparam SampleT type of the log values.
+ */
+template<unsigned int Columns, unsigned int Capacity = 4096, typename SampleT = float>
+struct TableLogBatch {
+    static constexpr unsigned int columns = Columns;
+    static constexpr unsigned int capacity = Capacity;
+    typedef SampleT Sample;
+
+    SampleT values[Columns][Capacity];
+    unsigned int count = 0;
+};
+
+/**
+ * Packed binary log.
+ * The file is a sequence of samples, each Columns values of SampleT in the byte order of
+ * this target, with no header. It is memory mapped, the samples are copied into the
+ * columns of each batch.
+ */
+template<unsigned int Columns, typename SampleT = float>
+class TableBinaryLog {
+public:
+    TableBinaryLog() = default;
+    TableBinaryLog(const TableBinaryLog&) = delete;
+    TableBinaryLog& operator=(const TableBinaryLog&) = delete;
+
+    ~TableBinaryLog() {
+        close();
+    }
+
+    /**
+     * Maps a log file.
+     * @param path the log file.
+     * @returns false if the file cannot be mapped or is not a whole number of samples.
+     */
+    bool open(const char* path) {
+        close();
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size % sizeof(Record) != 0) {
+            ::close(fd);
+            return false;
+        }
+        size = static_cast<size_t>(info.st_size);
+        if (size > 0) {
+            void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                ::close(fd);
+                size = 0;
+                return false;
+            }
+            madvise(mapped, size, MADV_SEQUENTIAL);
+            records = static_cast<const Record*>(mapped);
+        }
+        ::close(fd);
+        position = 0;
+        return true;
+    }
+
+    /**
+     * Unmaps the log.
+     */
+    void close() {
+        if (records != nullptr) {
+            munmap(const_cast<Record*>(records), size);
+        }
+        records = nullptr;
+        size = 0;
+        position = 0;
+    }
+
+    /**
+     * Reads the next batch.
+     * @param batch receives up to its capacity of samples.
+     * @returns the number of samples read, 0 at the end of the log.
+     */
+    template<unsigned int Capacity>
+    unsigned int read(TableLogBatch<Columns, Capacity, SampleT>& batch) {
+        const size_t remaining = samples() - position;
+        batch.count = remaining < Capacity ? static_cast<unsigned int>(remaining) : Capacity;
+        const Record* record = records + position;
+        for (unsigned int i = 0; i < batch.count; i++) {
+            for (unsigned int c = 0; c < Columns; c++) {
+                batch.values[c][i] = record[i].values[c];
+            }
+        }
+        position += batch.count;
+        return batch.count;
+    }
+
+    /**
+     * Rewinds to the first sample.
+     */
+    void rewind() {
+        position = 0;
+    }
+
+    /**
+     * Samples.
+     * @return the number of samples in the log.
+     */
+    size_t samples() const {
+        return size / sizeof(Record);
+    }
+
+private:
+    // a sample as stored.
+    struct Record {
+        SampleT values[Columns];
+    };
+
+    const Record* records = nullptr;
+    size_t size = 0;
+    size_t position = 0;
+};
+
+/**
+ * CSV log.
+ * Each line is a sample of at least Columns comma separated numbers, further fields are
+ * ignored. The file is read in chunks of chunkSize bytes, a line split by a chunk is
+ * completed from the next. Lines which do not start with Columns numbers, such as a
+ * header, are skipped and counted.
+ */
+template<unsigned int Columns, typename SampleT = float>
+class TableCsvLog {
+public:
+    /**
+     * @param chunkSize size of the read buffer in bytes, longer than any line.
+     */
+    explicit TableCsvLog(const unsigned int chunkSize = 1 << 20) : buffer(chunkSize + 1) {}
+    TableCsvLog(const TableCsvLog&) = delete;
+    TableCsvLog& operator=(const TableCsvLog&) = delete;
+
+    ~TableCsvLog() {
+        close();
+    }
+
+    /**
+     * Opens a log file.
+     * @param path the log file.
+     * @returns false if the file cannot be opened.
+     */
+    bool open(const char* path) {
+        close();
+        file = std::fopen(path, "rb");
+        begin = 0;
+        end = 0;
+        skipped = 0;
+        return file != nullptr;
+    }
+
+    /**
+     * Closes the log.
+     */
+    void close() {
+        if (file != nullptr) {
+            std::fclose(file);
+        }
+        file = nullptr;
+    }
+
+    /**
+     * Reads the next batch.
+     * @param batch receives up to its capacity of samples.
+     * @returns the number of samples read, 0 at the end of the log.
+     */
+    template<unsigned int Capacity>
+    unsigned int read(TableLogBatch<Columns, Capacity, SampleT>& batch) {
+        batch.count = 0;
+        while (batch.count < Capacity) {
+            char* line = nextLine();
+            if (line == nullptr) {
+                break;
+            }
+            if (!parse(line, batch, batch.count)) {
+                skipped++;
+                continue;
+            }
+            batch.count++;
+        }
+        return batch.count;
+    }
+
+    /**
+     * Get Skipped.
+     * @return the number of lines skipped as not samples.
+     */
+    unsigned long getSkipped() const {
+        return skipped;
+    }
+
+private:
+    std::FILE* file = nullptr;
+    // read buffer, the unparsed text is [begin, end).
+    std::vector<char> buffer;
+    size_t begin = 0;
+    size_t end = 0;
+    unsigned long skipped = 0;
+
+    /**
+     * Next Line.
+     * @return the next line terminated in place, nullptr at the end of the file.
+     */
+    char* nextLine() {
+        for (;;) {
+            for (size_t i = begin; i < end; i++) {
+                if (buffer[i] == '\n') {
+                    buffer[i] = '\0';
+                    char* line = &buffer[begin];
+                    begin = i + 1;
+                    return line;
+                }
+            }
+            // Move the partial line to the front and read the next chunk after it
+            const size_t partial = end - begin;
+            if (partial > 0 && begin > 0) {
+                memmove(&buffer[0], &buffer[begin], partial);
+            }
+            begin = 0;
+            end = partial;
+            const size_t read = file != nullptr && end < buffer.size() - 1 ? std::fread(&buffer[end], 1, buffer.size() - 1 - end, file) : 0;
+            if (read == 0) {
+                if (end == 0) {
+                    return nullptr;
+                }
+                // The last line has no line feed, or is longer than the chunk
+                buffer[end] = '\0';
+                end = 0;
+                return &buffer[0];
+            }
+            end += read;
+        }
+    }
+
+    /**
+     * Parse.
+     * @return false if the line does not start with Columns numbers.
+     */
+    template<unsigned int Capacity>
+    static bool parse(char* line, TableLogBatch<Columns, Capacity, SampleT>& batch, const unsigned int i) {
+        char* p = line;
+        for (unsigned int c = 0; c < Columns; c++) {
+            char* next = nullptr;
+            const double value = std::strtod(p, &next);
+            if (next == p) {
+                return false;
+            }
+            while (*next == ' ' || *next == '\t' || *next == '\r') next++;
+            if (c + 1 < Columns && *next != ',') {
+                return false;
+            }
+            batch.values[c][i] = static_cast<SampleT>(value);
+            p = *next == ',' ? next + 1 : next;
+        }
+        return true;
+    }
+};
+
+/**
+ * Error statistics of a replay channel.
+ */
+struct TableReplayStats {
+    unsigned long samples = 0;      // samples looked up.
+    unsigned long outOfBounds = 0;  // samples out of the table bounds, not compared.
+    unsigned long compared = 0;     // samples compared with the logged value.
+    double meanError = 0;           // mean of table - logged.
+    double meanAbsError = 0;        // mean of |table - logged|.
+    double rmsError = 0;            // root mean square of table - logged.
+    double maxAbsError = 0;         // largest |table - logged|.
+};
+
+/**
+ * Axis sizes, axis and compute types of a Table.
+ */
+template<typename TableT>
+struct TableReplayTraits;
+
+template<typename T, unsigned int xSize, unsigned int ySize, typename XAxisT, typename YAxisT, typename ComputeT,
+         typename Layout, unsigned int CacheSize, typename Stats, typename Index>
+struct TableReplayTraits<Table<T, xSize, ySize, XAxisT, YAxisT, ComputeT, Layout, CacheSize, Stats, Index>> {
+    static constexpr unsigned int xCount = xSize;
+    static constexpr unsigned int yCount = ySize;
+    typedef XAxisT XAxis;
+    typedef YAxisT YAxis;
+    typedef ComputeT Compute;
+};
+
+/**
+ * Replays the columns of a log through a table.
+ */
+template<typename TableT>
+class TableReplayChannel {
+public:
+    typedef typename TableReplayTraits<TableT>::XAxis XAxisT;
+    typedef typename TableReplayTraits<TableT>::YAxis YAxisT;
+    typedef typename TableReplayTraits<TableT>::Compute ComputeT;
+
+    // no column, for the y input of a (x, 1) table or the logged value.
+    static constexpr int none = -1;
+
+    /**
+     * @param table the table, used by reference.
+     * @param xColumn the log column of the x-axis input.
+     * @param yColumn the log column of the y-axis input, none for a (x, 1) table.
+     * @param loggedColumn the log column compared with the table, none to only look up.
+     * @param capacity the number of samples looked up at a time, the buffers are allocated once here.
+     */
+    TableReplayChannel(const TableT& table, const unsigned int xColumn, const int yColumn = none, const int loggedColumn = none,
+                       const unsigned int capacity = 4096)
+        : table(table), xColumn(xColumn), yColumn(yColumn), loggedColumn(loggedColumn),
+          X_in(capacity > 0 ? capacity : 1), Y_in(yColumn == none || capacity == 0 ? 1 : capacity), out(X_in.size()) {}
+
+    /**
+     * Process.
+     * Looks up a batch and adds it to the statistics. A batch larger than the capacity is
+     * looked up in parts of capacity samples, the output grows to hold the whole batch.
+     * @param batch the log samples.
+     * @returns the table values of the batch, -1 where out of bounds, valid until the next batch.
+     */
+    template<typename Batch>
+    const ComputeT* process(const Batch& batch) {
+        if (out.size() < batch.count) {
+            out.resize(batch.count);
+        }
+        const unsigned int capacity = static_cast<unsigned int>(X_in.size());
+        for (unsigned int start = 0; start < batch.count; start += capacity) {
+            lookup(batch, start, batch.count - start < capacity ? batch.count - start : capacity);
+        }
+        return out.data();
+    }
+
+    /**
+     * Get Stats.
+     * @return the error statistics of the batches processed.
+     */
+    TableReplayStats getStats() const {
+        TableReplayStats stats = counters;
+        if (stats.compared > 0) {
+            stats.meanError = sumError / stats.compared;
+            stats.meanAbsError = sumAbsError / stats.compared;
+            stats.rmsError = std::sqrt(sumSquaredError / stats.compared);
+        }
+        return stats;
+    }
+
+    /**
+     * Reset the statistics.
+     */
+    void resetStats() {
+        counters = TableReplayStats();
+        sumError = 0;
+        sumAbsError = 0;
+        sumSquaredError = 0;
+    }
+
+private:
+    const TableT& table;
+    const unsigned int xColumn;
+    const int yColumn;
+    const int loggedColumn;
+    // inputs and outputs of a batch.
+    std::vector<XAxisT> X_in;
+    std::vector<YAxisT> Y_in;
+    std::vector<ComputeT> out;
+    // statistics.
+    TableReplayStats counters;
+    double sumError = 0;
+    double sumAbsError = 0;
+    double sumSquaredError = 0;
+
+    /**
+     * Lookup.
+     * Looks up count samples of a batch from start, and adds them to the statistics.
+     */
+    template<typename Batch>
+    void lookup(const Batch& batch, const unsigned int start, const unsigned int count) {
+        for (unsigned int i = 0; i < count; i++) {
+            X_in[i] = toAxis<XAxisT>(batch.values[xColumn][start + i]);
+        }
+        if (yColumn == none) {
+            Y_in[0] = 1;
+            table.getValues(X_in.data(), &out[start], count);
+        } else {
+            for (unsigned int i = 0; i < count; i++) {
+                Y_in[i] = toAxis<YAxisT>(batch.values[yColumn][start + i]);
+            }
+            table.getValues(X_in.data(), Y_in.data(), &out[start], count);
+        }
+
+        // The bounds of the axes, an in bounds table value may be -1
+        const XAxisT xMin = table.getXAxisValueByIndex(0);
+        const XAxisT xMax = table.getXAxisValueByIndex(TableReplayTraits<TableT>::xCount - 1);
+        const YAxisT yMin = table.getYAxisValueByIndex(0);
+        const YAxisT yMax = table.getYAxisValueByIndex(TableReplayTraits<TableT>::yCount - 1);
+        counters.samples += count;
+        for (unsigned int i = 0; i < count; i++) {
+            const YAxisT y = yColumn == none ? Y_in[0] : Y_in[i];
+            if (X_in[i] < xMin || X_in[i] > xMax || y < yMin || y > yMax) {
+                counters.outOfBounds++;
+                continue;
+            }
+            if (loggedColumn == none) {
+                continue;
+            }
+            const double error = static_cast<double>(out[start + i]) - static_cast<double>(batch.values[loggedColumn][start + i]);
+            const double absError = std::fabs(error);
+            sumError += error;
+            sumAbsError += absError;
+            sumSquaredError += error * error;
+            if (absError > counters.maxAbsError) counters.maxAbsError = absError;
+            counters.compared++;
+        }
+    }
+
+    /**
+     * To Axis.
+     * @return the log value as an axis input, rounded to the nearest for integer axes.
+     */
+    template<typename AxisT, typename SampleT>
+    static AxisT toAxis(const SampleT value) {
+        if (static_cast<AxisT>(1) / 2 == 0) {
+            return static_cast<AxisT>(std::lround(value));
+        }
+        return static_cast<AxisT>(value);
+    }
+};
+
+#endif // EPICECU_TABLE_REPLAY_H
@@ -0,0 +1,302 @@
+#ifndef EPICECU_TABLE_SET_H
+#define EPICECU_TABLE_SET_H
+
+/**
+ * Table Set.
+ *
+ * K tables on the same x and y axes, such as the fuel, ignition, lambda target
+ * and VE maps on RPM x MAP. The axes are stored once, and one lookup searches
+ * them and computes the interpolation weights once for all K planes:
+ *
+ *   TableSet<uint8_t, 4, 16, 16> maps;
+ *   double out[4];
+ *   maps.getValues(2500, 80, out);
+ *
+ * The values of the K planes at each breakpoint are stored next to each other,
+ * so the four corners of a cell are four runs of K values for every plane.
+ *
+ * Copyright © 2022 David Cedar. All rights reserved.
+ * Licensed under the LGPL License (see LICENSE file)
+ */
+
+#include "Table.h"
+
+template<typename T, unsigned int K, unsigned int xSize, unsigned int ySize, typename XAxisT, typename YAxisT, typename ComputeT>
+class TableSet {
+    static_assert(K > 0, "A TableSet needs at least one plane");
+
+public:
+    // number of planes.
+    static constexpr unsigned int planes = K;
+
+    /**
+     * Initialises the TableSet object.
+     */
+    void initialise() {
+        resetData();
+        if(ySize == 1) axisY[0] = 1;
+        lastXIdx = 0;
+        lastYIdx = 0;
+    }
+
+    /**
+     * Gets the value of every plane by x,y axis value/s.
+     * Starts the search of each axis at the previous cell.
+     * @param X_in The x-axis value.
+     * @param Y_in The y-axis value.
+     * @param out array receiving the value of each plane. -1 if out of bounds.
+     * @returns false if out of bounds.
+     */
+    bool getValues(const XAxisT X_in, const YAxisT Y_in, ComputeT (&out)[K]) {
+        if (!inBounds(X_in, Y_in, out)) {
+            return false;
+        }
+        Lookup::findSegmentFast(axisX, xSize, xSpacing, X_in, lastXIdx);
+        Lookup::findSegmentFast(axisY, ySize, ySpacing, Y_in, lastYIdx);
+        interpolate(X_in, Y_in, lastXIdx, lastYIdx, out);
+        return true;
+    }
+
+    /**
+     * Gets the value of every plane by x axis value.
+     * @param X_in The x-axis value.
+     * @param out array receiving the value of each plane. -1 if out of bounds.
+     * @returns false if out of bounds.
+     */
+    bool getValues(const XAxisT X_in, ComputeT (&out)[K]) {
+        return getValues(X_in, 1, out);
+    }
+
+    /**
+     * Gets the value of every plane by x,y axis value/s, without the cache.
+     * @param X_in The x-axis value.
+     * @param Y_in The y-axis value.
+     * @param out array receiving the value of each plane. -1 if out of bounds.
+     * @returns false if out of bounds.
+     */
+    bool getValues(const XAxisT X_in, const YAxisT Y_in, ComputeT (&out)[K]) const {
+        if (!inBounds(X_in, Y_in, out)) {
+            return false;
+        }
+        interpolate(X_in, Y_in, Lookup::findSegment(axisX, xSize, xSpacing, X_in), Lookup::findSegment(axisY, ySize, ySpacing, Y_in), out);
+        return true;
+    }
+
+    /**
+     * Gets the value of every plane by x axis value, without the cache.
+     * @param X_in The x-axis value.
+     * @param out array receiving the value of each plane. -1 if out of bounds.
+     * @returns false if out of bounds.
+     */
+    bool getValues(const XAxisT X_in, ComputeT (&out)[K]) const {
+        return getValues(X_in, 1, out);
+    }
+
+    /**
+     * Gets the value of one plane by x,y axis value/s.
+     * @param k the plane.
+     * @param X_in The x-axis value.
+     * @param Y_in The y-axis value.
+     * @returns The plane value. -1 if out of bounds or k is not a plane.
+     */
+    ComputeT getValue(const unsigned int k, const XAxisT X_in, const YAxisT Y_in) {
+        if (k >= K) {
+            return -1;
+        }
+        ComputeT out[K];
+        getValues(X_in, Y_in, out);
+        return out[k];
+    }
+
+    /**
+     * Set Value by Plane, X and Y Index.
+     * @param k the plane.
+     * @param x index of the row in the table.
+     * @param y index of the column in the table.
+     * @param value to set.
+     * @returns True if the value was set successfully, False otherwise.
+     */
+    bool setValueByIndex(const unsigned int k, const unsigned int x, const unsigned int y, const T value) {
+        if (k >= K || x >= xSize || y >= ySize) {
+            return false;
+        }
+        values[(x * ySize + y) * K + k] = value;
+        return true;
+    }
+
+    /**
+     * Get Value by Plane, X and Y index.
+     * @param k the plane.
+     * @param x index of the row in the table.
+     * @param y index of the column in the table.
+     * @return value at index (x,y) of the plane.
+     */
+    T getValueByIndex(const unsigned int k, const unsigned int x, const unsigned int y) const {
+        return values[(x * ySize + y) * K + k];
+    }
+
+    /**
+     * Set X Axis Value by Index.
+     * @param x index of the row in the table.
+     * @param value to set.
+     * @returns True if the value was set successfully, False otherwise.
+     */
+    bool setXAxisValueByIndex(const unsigned int x, const XAxisT value) {
+        if (x >= xSize) {
+            return false;
+        }
+        axisX[x] = value;
+        xSpacing = Lookup::detectSpacing(axisX, xSize);
+        return true;
+    }
+
+    /**
+     * Set Y Axis Value by Index.
+     * @param y index of the column in the table.
+     * @param value to set.
+     * @returns True if the value was set successfully, False otherwise.
+     */
+    bool setYAxisValueByIndex(const unsigned int y, const YAxisT value) {
+        if (y >= ySize) {
+            return false;
+        }
+        axisY[y] = value;
+        ySpacing = Lookup::detectSpacing(axisY, ySize);
+        return true;
+    }
+
+    /**
+     * Set X Axis.
+     * Replaces every x-axis breakpoint, the spacing is detected once.
+     * @param axis the x-axis values, sorted strictly ascending.
+     * @param count number of values, xSize.
+     * @returns True if the axis was set, False if the count is wrong or the values are not ascending.
+     */
+    bool setXAxis(const XAxisT* axis, const unsigned int count) {
+        if (count != xSize || !Lookup::isAscending(axis, count)) {
+            return false;
+        }
+        memcpy(axisX, axis, sizeof(axisX));
+        xSpacing = Lookup::detectSpacing(axisX, xSize);
+        return true;
+    }
+
+    /**
+     * Set Y Axis.
+     * Replaces every y-axis breakpoint, the spacing is detected once.
+     * @param axis the y-axis values, sorted strictly ascending.
+     * @param count number of values, ySize.
+     * @returns True if the axis was set, False if the count is wrong or the values are not ascending.
+     */
+    bool setYAxis(const YAxisT* axis, const unsigned int count) {
+        if (count != ySize || !Lookup::isAscending(axis, count)) {
+            return false;
+        }
+        memcpy(axisY, axis, sizeof(axisY));
+        ySpacing = Lookup::detectSpacing(axisY, ySize);
+        return true;
+    }
+
+    /**
+     * Set Plane.
+     * Replaces every value of one plane.
+     * @param k the plane.
+     * @param data the plane values, the y values of each x index in turn.
+     * @param count number of values, xSize * ySize.
+     * @returns True if the values were set successfully, False otherwise.
+     */
+    bool setPlane(const unsigned int k, const T* data, const unsigned int count) {
+        if (k >= K || count != xSize * ySize) {
+            return false;
+        }
+        for (unsigned int i = 0; i < xSize * ySize; i++) values[i * K + k] = data[i];
+        return true;
+    }
+
+    /**
+     * Get X Axis Value by Index.
+     * @param x index of the row in the table.
+     * @return the breakpoint.
+     */
+    XAxisT getXAxisValueByIndex(const unsigned int x) const {
+        return axisX[x];
+    }
+
+    /**
+     * Get Y Axis Value by Index.
+     * @param y index of the column in the table.
+     * @return the breakpoint.
+     */
+    YAxisT getYAxisValueByIndex(const unsigned int y) const {
+        return axisY[y];
+    }
+
+    /**
+     * Reset the data to zero.
+     */
+    void resetData() {
+        for (auto& e : values) e = 0;
+        for (auto& e : axisX) e = 0;
+        for (auto& e : axisY) e = 0;
+        xSpacing = AxisSpacing();
+        ySpacing = AxisSpacing();
+    }
+
+protected:
+    // plane values, the K values of each breakpoint in turn.
+    T values[xSize * ySize * K] = {0};
+    XAxisT axisX[xSize] = {0};
+    YAxisT axisY[ySize] = {0};
+
+private:
+    // the segment search and spacing detection of Table.
+    typedef Table<T, xSize, ySize, XAxisT, YAxisT, ComputeT> Lookup;
+    typedef typename Lookup::AxisSpacing AxisSpacing;
+
+    // axis spacing, detected when an axis is set.
+    AxisSpacing xSpacing;
+    AxisSpacing ySpacing;
+    // bracket caching.
+    unsigned int lastXIdx = 0;
+    unsigned int lastYIdx = 0;
+
+    /**
+     * In Bounds.
+     * @param out set to -1 when the input is out of bounds.
+     * @return true if the input is within both axes.
+     */
+    bool inBounds(const XAxisT X_in, const YAxisT Y_in, ComputeT (&out)[K]) const {
+        if(X_in > axisX[xSize-1] || Y_in > axisY[ySize-1] || X_in < axisX[0] || Y_in < axisY[0]){
+            for (auto& e : out) e = -1;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Interpolate.
+     * Computes the weights of the cell once, then interpolates each plane.
+     * @param X_in The x-axis value.
+     * @param Y_in The y-axis value.
+     * @param xMinIdx the x-axis segment containing X_in.
+     * @param yMinIdx the y-axis segment containing Y_in.
+     * @param out array receiving the value of each plane.
+     */
+    void interpolate(const XAxisT X_in, const YAxisT Y_in, const unsigned int xMinIdx, const unsigned int yMinIdx, ComputeT (&out)[K]) const {
+        const unsigned int xMaxIdx = xSize > 1 ? xMinIdx + 1 : xMinIdx;
+        const unsigned int yMaxIdx = ySize > 1 ? yMinIdx + 1 : yMinIdx;
+        const ComputeT fx = xMaxIdx != xMinIdx ? static_cast<ComputeT>(X_in - axisX[xMinIdx]) / static_cast<ComputeT>(axisX[xMaxIdx] - axisX[xMinIdx]) : 0;
+        const ComputeT fy = yMaxIdx != yMinIdx ? static_cast<ComputeT>(Y_in - axisY[yMinIdx]) / static_cast<ComputeT>(axisY[yMaxIdx] - axisY[yMinIdx]) : 0;
+        const T* q11 = &values[(xMinIdx * ySize + yMinIdx) * K];
+        const T* q12 = &values[(xMinIdx * ySize + yMaxIdx) * K];
+        const T* q21 = &values[(xMaxIdx * ySize + yMinIdx) * K];
+        const T* q22 = &values[(xMaxIdx * ySize + yMaxIdx) * K];
+        for (unsigned int k = 0; k < K; k++) {
+            const ComputeT r1 = q11[k] + (static_cast<ComputeT>(q21[k]) - q11[k]) * fx;
+            const ComputeT r2 = q12[k] + (static_cast<ComputeT>(q22[k]) - q12[k]) * fx;
+            out[k] = r1 + (r2 - r1) * fy;
+        }
+    }
+};
+
+#endif // EPICECU_TABLE_SET_H
@@ -0,0 +1,184 @@
+#ifndef EPICECU_TABLE_STATS_H
+#define EPICECU_TABLE_STATS_H
+
+/**
+ * Table Stats.
+ *
+ * Instrumentation policies for the lookups of a Table. TableNoStats, the default,
+ * compiles to nothing. TableCountingStats counts the lookups by the path they take
+ * and measures their duration with a cycle counter:
+ *
+ *   TableDwtCycleCounter     DWT CYCCNT on Cortex-M3/M4/M7/M33, call enable() once at start up
+ *   TableTscCycleCounter     rdtsc on x86
+ *   TableSteadyCycleCounter  std::chrono::steady_clock, in nanoseconds
+ *
+ * TableDefaultCycleCounter is the first of these available on the target.
+ * The counters are not atomic, read them from the thread which does the lookups
+ * or accept an occasionally torn snapshot.
+ *
+ * Copyright © 2022 David Cedar. All rights reserved.
+ * Licensed under the LGPL License (see LICENSE file)
+ */
+
+#include <stdint.h>
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+#define TABLE_CYCLES_DWT
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TABLE_CYCLES_TSC
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define TABLE_CYCLES_TSC
+#endif
+
+#if !defined(ARDUINO)
+#include <chrono>
+#define TABLE_CYCLES_STEADY
+#endif
+
+/**
+ * Counters of a table, as read by the telemetry.
+ */
+struct TableStatsSnapshot {
+    unsigned long calls = 0;            // getValue calls.
+    unsigned long resultCacheHits = 0;  // calls answered with a cached result.
+    unsigned long outOfBounds = 0;      // calls with an input out of bounds, returning -1.
+    unsigned long exactHits = 0;        // inputs on a breakpoint of both axes, no interpolation.
+    unsigned long linear = 0;           // 1D interpolations.
+    unsigned long bilinear = 0;         // 2D interpolations.
+    unsigned long searchSteps = 0;      // axis probes of the segment searches.
+    unsigned long minCycles = 0;        // shortest call.
+    unsigned long maxCycles = 0;        // longest call.
+    unsigned long long totalCycles = 0; // all calls.
+};
+
+/**
+ * No instrumentation.
+ */
+struct TableNoStats {
+    struct Scope {
+        explicit Scope(const TableNoStats&) {}
+    };
+    void resultCacheHit() const {}
+    void outOfBounds() const {}
+    void exactHit() const {}
+    void linear() const {}
+    void bilinear() const {}
+    void searchSteps(const unsigned int) const {}
+    TableStatsSnapshot snapshot() const {
+        return TableStatsSnapshot();
+    }
+    void reset() {}
+};
+
+#if defined(TABLE_CYCLES_DWT)
+/**
+ * DWT cycle counter of the Cortex-M3 and later.
+ */
+struct TableDwtCycleCounter {
+    typedef uint32_t Ticks;
+
+    /**
+     * Enables the trace unit and starts the cycle counter.
+     */
+    static void enable(){
+        *reinterpret_cast<volatile uint32_t*>(0xE000EDFC) |= (1UL << 24); // DEMCR.TRCENA
+        *reinterpret_cast<volatile uint32_t*>(0xE0001004) = 0;            // DWT_CYCCNT
+        *reinterpret_cast<volatile uint32_t*>(0xE0001000) |= 1UL;         // DWT_CTRL.CYCCNTENA
+    }
+
+    static Ticks now(){
+        return *reinterpret_cast<volatile uint32_t*>(0xE0001004);
+    }
+};
+#endif
+
+#if defined(TABLE_CYCLES_TSC)
+/**
+ * Time stamp counter of x86.
+ */
+struct TableTscCycleCounter {
+    typedef unsigned long long Ticks;
+
+    static Ticks now(){
+        return __rdtsc();
+    }
+};
+#endif
+
+#if defined(TABLE_CYCLES_STEADY)
+/**
+ * std::chrono::steady_clock, counts nanoseconds.
+ */
+struct TableSteadyCycleCounter {
+    typedef unsigned long long Ticks;
+
+    static Ticks now(){
+        return static_cast<Ticks>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+};
+#endif
+
+/**
+ * No cycle counter, the durations are 0.
+ */
+struct TableNoCycleCounter {
+    typedef unsigned long Ticks;
+
+    static Ticks now(){
+        return 0;
+    }
+};
+
+#if defined(TABLE_CYCLES_DWT)
+typedef TableDwtCycleCounter TableDefaultCycleCounter;
+#elif defined(TABLE_CYCLES_TSC)
+typedef TableTscCycleCounter TableDefaultCycleCounter;
+#elif defined(TABLE_CYCLES_STEADY)
+typedef TableSteadyCycleCounter TableDefaultCycleCounter;
+#else
+typedef TableNoCycleCounter TableDefaultCycleCounter;
+#endif
+
+/**
+ * Counts the lookups of a table and measures them with a cycle counter.
+ * The counters are updated by const lookups too, so they are mutable.
+ */
+template<typename CycleCounter = TableDefaultCycleCounter>
+struct TableCountingStats {
+    // times a lookup from construction to destruction.
+    struct Scope {
+        explicit Scope(const TableCountingStats& s) : stats(s), start(CycleCounter::now()) {
+            stats.counters.calls++;
+        }
+        ~Scope() {
+            const unsigned long cycles = static_cast<unsigned long>(static_cast<typename CycleCounter::Ticks>(CycleCounter::now() - start));
+            TableStatsSnapshot& c = stats.counters;
+            if (c.calls == 1 || cycles < c.minCycles) c.minCycles = cycles;
+            if (cycles > c.maxCycles) c.maxCycles = cycles;
+            c.totalCycles += cycles;
+        }
+        const TableCountingStats& stats;
+        const typename CycleCounter::Ticks start;
+    };
+
+    void resultCacheHit() const { counters.resultCacheHits++; }
+    void outOfBounds() const { counters.outOfBounds++; }
+    void exactHit() const { counters.exactHits++; }
+    void linear() const { counters.linear++; }
+    void bilinear() const { counters.bilinear++; }
+    void searchSteps(const unsigned int steps) const { counters.searchSteps += steps; }
+
+    TableStatsSnapshot snapshot() const {
+        return counters;
+    }
+
+    void reset() {
+        counters = TableStatsSnapshot();
+    }
+
+    mutable TableStatsSnapshot counters;
+};
+
+#endif // EPICECU_TABLE_STATS_H
@@ -0,0 +1,147 @@
+#ifndef EPICECU_TABLE_VIEW_H
+#define EPICECU_TABLE_VIEW_H
+
+/**
+ * Table View.
+ *
+ * A read only Table over memory it does not own, such as a calibration in flash,
+ * an EEPROM shadow or a memory mapped file. The memory holds a table image as
+ * written by Table::saveData, lookups run in place with no copy.
+ *
+ * Copyright © 2022 David Cedar. All rights reserved.
+ * Licensed under the LGPL License (see LICENSE file)
+ */
+
+#include "Table.h"
+
+template<typename T, unsigned int xSize, unsigned int ySize, typename XAxisT, typename YAxisT, typename ComputeT>
+class TableView {
+public:
+    /**
+     * Constructs an unbound view, bind() attaches it to an image.
+     */
+    TableView() = default;
+
+    /**
+     * Constructs a view over an image.
+     * @param image pointer to the image.
+     * @param size size of the image in bytes.
+     */
+    TableView(const void* image, unsigned int size) {
+        bind(image, size);
+    }
+
+    /**
+     * Attaches the view to an image.
+     * The image must be in the byte order of this target and aligned for the value and axis types.
+     * The header and crc are checked once here, not on every lookup.
+     * @param image pointer to the image.
+     * @param size size of the image in bytes.
+     * @returns true if the image is valid for this view.
+     */
+    bool bind(const void* image, unsigned int size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(image);
+        bool swapped = false;
+        values = nullptr;
+        axisX = nullptr;
+        axisY = nullptr;
+        if (image == nullptr || !isAligned(image) || !Image::check(bytes, size, swapped) || swapped) {
+            return false;
+        }
+        values = reinterpret_cast<const T*>(bytes + Image::valuesOffset());
+        axisX = reinterpret_cast<const XAxisT*>(bytes + Image::xAxisOffset());
+        axisY = reinterpret_cast<const YAxisT*>(bytes + Image::yAxisOffset());
+        xSpacing = Lookup::detectSpacing(axisX, xSize);
+        ySpacing = Lookup::detectSpacing(axisY, ySize);
+        return true;
+    }
+
+    /**
+     * Is Valid.
+     * @return true if the view is bound to a valid image.
+     */
+    bool isValid() const {
+        return values != nullptr;
+    }
+
+    /**
+     * Gets the value table value by x,y axis value/s.
+     * @param X_in The x-axis value.
+     * @param Y_in The y-axis value.
+     * @returns The table value. -1 if out of bounds or the view is not bound.
+     */
+    ComputeT getValue(const XAxisT X_in, const YAxisT Y_in) const {
+        // Check if requesting over bounds
+        if(!isValid() || X_in > axisX[xSize-1] || Y_in > axisY[ySize-1] || X_in < axisX[0] || Y_in < axisY[0]){
+            return -1;
+        }
+        return Lookup::interpolate(values, axisX, axisY, X_in, Y_in,
+                                   Lookup::findSegment(axisX, xSize, xSpacing, X_in),
+                                   Lookup::findSegment(axisY, ySize, ySpacing, Y_in), TableNoStats());
+    }
+
+    /**
+     * Retrieves the value of a specific position.
+     * @param X_in The x-axis value.
+     * @returns The table value. -1 if out of bounds or the view is not bound.
+     */
+    ComputeT getValue(const XAxisT X_in) const {
+        return getValue(X_in, 1);
+    }
+
+    /**
+     * Get Value by X and Y index.
+     * @param x index of the row in the table.
+     * @param y index of the column in the table.
+     * @return value at index (x,y). 0 if the view is not bound.
+     */
+    T getValueByIndex(const unsigned int x, const unsigned int y) const {
+        if(!isValid()){
+            return 0;
+        }
+        return values[x * ySize + y];
+    }
+
+    /**
+     * Get Value by X index.
+     * @param x index of the row in the table.
+     * @return value at index x. 0 if the view is not bound.
+     */
+    T getValueByIndex(const unsigned int x) const {
+        return getValueByIndex(x, 0);
+    }
+
+    /**
+     * Get Size.
+     * @return size of the table image in bytes.
+     */
+    static constexpr unsigned int getSize(){
+        return Image::size();
+    }
+
+private:
+    // the images are in row major order.
+    typedef Table<T, xSize, ySize, XAxisT, YAxisT, ComputeT, TableRowMajor> Lookup;
+    typedef TableImage<T, xSize, ySize, XAxisT, YAxisT> Image;
+    typedef typename Lookup::AxisSpacing AxisSpacing;
+
+    // external table memory.
+    const T* values = nullptr;
+    const XAxisT* axisX = nullptr;
+    const YAxisT* axisY = nullptr;
+    // axis spacing, detected when bound.
+    AxisSpacing xSpacing;
+    AxisSpacing ySpacing;
+
+    /**
+     * Is Aligned.
+     * The sections are 8 byte aligned within the image, so the image start decides the alignment.
+     * @return true if the values and axes can be read in place.
+     */
+    static bool isAligned(const void* image){
+        const uintptr_t address = reinterpret_cast<uintptr_t>(image);
+        return address % alignof(T) == 0 && address % alignof(XAxisT) == 0 && address % alignof(YAxisT) == 0;
+    }
+};
+
+#endif // EPICECU_TABLE_VIEW_H
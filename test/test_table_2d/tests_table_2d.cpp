@@ -33,6 +33,9 @@ void run_tests()
   RUN_TEST(test_tableLookup_exactAxis);
   RUN_TEST(test_tableLookup_overMaxX);
   RUN_TEST(test_tableLookup_underMinX);
+  RUN_TEST(test_tableLookup_powerOfTwoAxis);
+  RUN_TEST(test_tableLookup_floatAxis);
+  RUN_TEST(test_getValues);
   UNITY_END(); // stop unit testing
   
 }
@@ -92,6 +95,68 @@ void test_tableLookup_underMinX(void)
   TEST_ASSERT_EQUAL(-1, value);
 }
 
+void test_tableLookup_powerOfTwoAxis(void)
+{
+  //Tests lookups on an axis spaced by a power of two
+  setup_testMap();
+
+  constexpr int tempXAxis[xSize] = {0, 16, 32, 48, 64};
+  for (unsigned int x = 0; x < xSize; x++) { testMap.setXAxisValueByIndex(x, tempXAxis[x]); }
+  TEST_ASSERT_TRUE(testMap.isXAxisUniform());
+
+  TEST_ASSERT_EQUAL(20, testMap.getValue(0));
+  TEST_ASSERT_EQUAL(60, testMap.getValue(24));
+  TEST_ASSERT_EQUAL(80, testMap.getValue(32));
+  TEST_ASSERT_EQUAL(87.5, testMap.getValue(56));
+  TEST_ASSERT_EQUAL(90, testMap.getValue(64));
+  TEST_ASSERT_EQUAL(-1, testMap.getValue(65));
+}
+
+void test_tableLookup_floatAxis(void)
+{
+  //Tests lookups on an evenly spaced floating point axis, which is searched rather than indexed
+  Table<uint8_t, xSize, 1, float> floatMap;
+  floatMap.initialise();
+  constexpr float tempXAxis[xSize] = {0, 0.5f, 1, 1.5f, 2};
+  for (unsigned int x = 0; x < xSize; x++) { floatMap.setXAxisValueByIndex(x, tempXAxis[x]); }
+  for (unsigned int x = 0; x < xSize; x++) { floatMap.setValueByIndex(x, 0, tempRow1[x]); }
+  TEST_ASSERT_FALSE(floatMap.isXAxisUniform());
+
+  TEST_ASSERT_EQUAL(20, floatMap.getValue(0));
+  TEST_ASSERT_EQUAL(60, floatMap.getValue(0.75f));
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 82, floatMap.getValue(1.2f));
+  TEST_ASSERT_EQUAL(90, floatMap.getValue(2));
+  TEST_ASSERT_EQUAL(-1, floatMap.getValue(2.25f));
+
+  const Table<uint8_t, xSize, 1, float>& constMap = floatMap;
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 82, constMap.getValue(1.2f));
+  const float x_axis[3] = {0.25f, 1.2f, 1.75f};
+  double values[3];
+  floatMap.getValues(x_axis, values, 3);
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 30, values[0]);
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 82, values[1]);
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 87.5, values[2]);
+}
+
+void test_getValues(void)
+{
+  //Tests a batch of lookups against the single lookups
+  setup_testMap();
+
+  constexpr unsigned int count = 7;
+  constexpr int x_axis[count] = {30, 20, 0, 80, 79, -10, 10000};
+  double values[count];
+  testMap.getValues(x_axis, values, count);
+
+  TEST_ASSERT_EQUAL(60, values[0]);
+  TEST_ASSERT_EQUAL(40, values[1]);
+  TEST_ASSERT_EQUAL(20, values[2]);
+  TEST_ASSERT_EQUAL(90, values[3]);
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, testMap.getValue(79), values[4]);
+  TEST_ASSERT_EQUAL(-1, values[5]);
+  TEST_ASSERT_EQUAL(-1, values[6]);
+}
+
 void setUp (void) {}
 
 void tearDown (void) {}
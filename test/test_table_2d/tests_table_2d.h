@@ -8,6 +8,9 @@ void test_tableLookup_50pct(void);
 void test_tableLookup_exactAxis(void);
 void test_tableLookup_overMaxX(void);
 void test_tableLookup_underMinX(void);
+void test_tableLookup_powerOfTwoAxis(void);
+void test_tableLookup_floatAxis(void);
+void test_getValues(void);
 void test_all_incrementing(void);
 
 constexpr unsigned int xSize = 5;
@@ -7,6 +7,21 @@
 Table<uint8_t, xSize, ySize> testMap;
 Table<uint8_t, xSize/2, ySize/2> secondMap;
 
+// Read only table, the same values as testMap
+constexpr Table<uint8_t, xSize, ySize> romMap(
+  {10, 20, 30, 40},
+  {10, 20, 30, 40},
+  { 5, 10, 15, 20,
+   40, 35, 30, 25,
+   45, 50, 55, 60,
+   80, 75, 70, 65});
+static_assert(romMap.getValueByIndex(1, 1) == 35, "The Table is constructed at compile time");
+
+// Storage is sized exactly, Table.h bounds the fixed overhead
+static_assert(sizeof(Table<uint32_t, 16, 16>) - sizeof(Table<uint8_t, 16, 16>) == 16 * 16 * (sizeof(uint32_t) - sizeof(uint8_t)),
+              "Table storage must be sized to its element count");
+static_assert(sizeof(Table<uint8_t, 5, 5, int, int, double, TableTiled<4>>) >= 8 * 8, "Tiled storage is padded to whole tiles");
+
 void setup_testMap(void)
 {
   //Setup the 3d table with some sane values for testing
@@ -40,6 +55,7 @@ void run_tests()
   RUN_TEST(test_tableLookup_50pct);
   RUN_TEST(test_tableLookup_exact1Axis);
   RUN_TEST(test_tableLookup_exact2Axis);
+  RUN_TEST(test_tableLookup_lastCell);
   RUN_TEST(test_tableLookup_overMaxX);
   RUN_TEST(test_tableLookup_overMaxY);
   RUN_TEST(test_tableLookup_underMinX);
@@ -47,6 +63,16 @@ void run_tests()
   RUN_TEST(test_setValue);
   RUN_TEST(test_setValueNonDirect);
   RUN_TEST(test_copyData);
+  RUN_TEST(test_bracketCache);
+  RUN_TEST(test_uniformAxis);
+  RUN_TEST(test_getValues);
+  RUN_TEST(test_getValueFixed);
+  RUN_TEST(test_getValueFixed16);
+  RUN_TEST(test_layouts);
+  RUN_TEST(test_constTable);
+  RUN_TEST(test_lookupContext);
+  RUN_TEST(test_cacheSize);
+  RUN_TEST(test_bulkSetters);
   UNITY_END(); // stop unit testing
   
 }
@@ -97,6 +123,18 @@ void test_tableLookup_exact2Axis(void)
   TEST_ASSERT_EQUAL(62.5, value);
 }
 
+void test_tableLookup_lastCell(void)
+{
+  //Tests lookups on the upper corner and inside the last cell of the table
+  setup_testMap();
+
+  double value = testMap.getValue(40, 40);
+  TEST_ASSERT_EQUAL(65, value);
+
+  value = testMap.getValue(35, 35);
+  TEST_ASSERT_EQUAL(62.5, value);
+}
+
 void test_tableLookup_overMaxX(void)
 {
   //Tests a lookup where the x_axis exceeds the highest value in the table. The Y value is a 50% match
@@ -208,6 +246,321 @@ void test_copyData()
 
 }
 
+void test_bracketCache()
+{
+  setup_testMap();
+
+  // Uneven axes so the cell is searched for
+  testMap.setXAxisValueByIndex(0, 5);
+  testMap.setYAxisValueByIndex(0, 5);
+  testMap.resetBracketCacheStats();
+
+  // Same cell and neighbouring cells are found without a full search
+  testMap.getValue(15, 15);
+  testMap.getValue(25, 25);
+  testMap.getValue(38, 12);
+  TEST_ASSERT_EQUAL(3, testMap.getBracketCacheHits());
+  TEST_ASSERT_EQUAL(0, testMap.getBracketCacheMisses());
+
+  // Jumping over a cell requires a full search, the result is unchanged
+  double value = testMap.getValue(15, 35);
+  TEST_ASSERT_EQUAL(3, testMap.getBracketCacheHits());
+  TEST_ASSERT_EQUAL(1, testMap.getBracketCacheMisses());
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 24.1667, value);
+
+  testMap.resetBracketCacheStats();
+  TEST_ASSERT_EQUAL(0, testMap.getBracketCacheHits());
+  TEST_ASSERT_EQUAL(0, testMap.getBracketCacheMisses());
+}
+
+void test_uniformAxis()
+{
+  setup_testMap();
+
+  // Evenly spaced axes are indexed directly
+  TEST_ASSERT_TRUE(testMap.isXAxisUniform());
+  TEST_ASSERT_TRUE(testMap.isYAxisUniform());
+  TEST_ASSERT_EQUAL(5, testMap.getValue(10, 10));
+  TEST_ASSERT_EQUAL(22.5, testMap.getValue(15, 15));
+  TEST_ASSERT_EQUAL(62.5, testMap.getValue(35, 35));
+  TEST_ASSERT_EQUAL(65, testMap.getValue(40, 40));
+
+  // Uneven axes fall back to the search
+  testMap.setXAxisValueByIndex(3, 50);
+  TEST_ASSERT_FALSE(testMap.isXAxisUniform());
+  TEST_ASSERT_TRUE(testMap.isYAxisUniform());
+  TEST_ASSERT_EQUAL(62.5, testMap.getValue(40, 35));
+}
+
+void test_getValues()
+{
+  setup_testMap();
+
+  // Batch lookups match the single lookups, including exact cells and out of bounds
+  constexpr unsigned int count = 9;
+  constexpr int x_axis[count] = {15, 10, 35, 40, 10000, 25, 12, 33, 20};
+  constexpr int y_axis[count] = {15, 15, 30, 40, 35, -10, 38, 21, 20};
+  double values[count];
+  testMap.getValues(x_axis, y_axis, values, count);
+
+  for (unsigned int i = 0; i < count; i++) {
+    TEST_ASSERT_FLOAT_WITHIN(0.0001, testMap.getValue(x_axis[i], y_axis[i]), values[i]);
+  }
+  TEST_ASSERT_EQUAL(-1, values[4]);
+  TEST_ASSERT_EQUAL(-1, values[5]);
+
+  // Uneven axes take the searched path
+  testMap.setXAxisValueByIndex(0, 5);
+  testMap.getValues(x_axis, y_axis, values, count);
+  for (unsigned int i = 0; i < count; i++) {
+    TEST_ASSERT_FLOAT_WITHIN(0.0001, testMap.getValue(x_axis[i], y_axis[i]), values[i]);
+  }
+}
+
+void test_getValueFixed()
+{
+  setup_testMap();
+
+  // Error bound of the fixed point path, the largest neighbouring cell difference is 35
+  constexpr unsigned int fracBits = 8;
+  constexpr double scale = 1 << fracBits;
+  constexpr double bound = (2 * 35 + 1) / scale;
+
+  TEST_ASSERT_EQUAL(5 * 256, testMap.getValueFixed<fracBits>(10, 10));
+  TEST_ASSERT_EQUAL(22.5 * 256, testMap.getValueFixed<fracBits>(15, 15));
+  TEST_ASSERT_EQUAL(-256, testMap.getValueFixed<fracBits>(10000, 35));
+  TEST_ASSERT_EQUAL(-256, testMap.getValueFixed<fracBits>(25, -10));
+
+  // Evenly spaced axes
+  for (int x = 10; x <= 40; x++) {
+    for (int y = 10; y <= 40; y += 3) {
+      TEST_ASSERT_FLOAT_WITHIN(bound, testMap.getValue(x, y), testMap.getValueFixed<fracBits>(x, y) / scale);
+    }
+  }
+
+  // Uneven axes
+  testMap.setXAxisValueByIndex(1, 17);
+  testMap.setYAxisValueByIndex(2, 33);
+  for (int x = 10; x <= 40; x++) {
+    for (int y = 10; y <= 40; y += 3) {
+      TEST_ASSERT_FLOAT_WITHIN(bound, testMap.getValue(x, y), testMap.getValueFixed<fracBits>(x, y) / scale);
+    }
+  }
+}
+
+void test_getValueFixed16()
+{
+  // 16 bit values with 16 fractional bits need a 64 bit accumulator
+  Table<uint16_t, 3, 3> map;
+  map.initialise();
+  constexpr int axis[3] = {0, 250, 500};
+  constexpr uint16_t cells[9] = {0, 1000, 2000, 30000, 40000, 65535, 100, 200, 300};
+  for (unsigned int i = 0; i < 3; i++) { map.setXAxisValueByIndex(i, axis[i]); }
+  for (unsigned int i = 0; i < 3; i++) { map.setYAxisValueByIndex(i, axis[i] * 2); }
+  for (unsigned int i = 0; i < 9; i++) { map.setValueByIndex(i / 3, i % 3, cells[i]); }
+
+  constexpr double scale = 65536.0;
+  constexpr double bound = (2 * 65435.0 + 1) / scale;
+  for (int x = 0; x <= 500; x += 7) {
+    for (int y = 0; y <= 1000; y += 11) {
+      TEST_ASSERT_FLOAT_WITHIN(bound, map.getValue(x, y), (map.getValueFixed<16, long long>(x, y)) / scale);
+    }
+  }
+}
+
+template<typename Layout>
+void check_layout()
+{
+  Table<uint16_t, 5, 7, int, int, double, Layout> map;
+  map.initialise();
+  for (unsigned int x = 0; x < 5; x++) { map.setXAxisValueByIndex(x, x * 10); }
+  for (unsigned int y = 0; y < 7; y++) { map.setYAxisValueByIndex(y, y * 10); }
+  for (unsigned int x = 0; x < 5; x++) {
+    for (unsigned int y = 0; y < 7; y++) { map.setValueByIndex(x, y, x * 100 + y); }
+  }
+
+  for (unsigned int x = 0; x < 5; x++) {
+    for (unsigned int y = 0; y < 7; y++) { TEST_ASSERT_EQUAL(x * 100 + y, map.getValueByIndex(x, y)); }
+  }
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 153.5, map.getValue(15, 35));
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 406, map.getValue(40, 60));
+}
+
+void test_layouts()
+{
+  check_layout<TableRowMajor>();
+  check_layout<TableColumnMajor>();
+  check_layout<TableTiled<2>>();
+  check_layout<TableTiled<4>>();
+}
+
+void test_constTable()
+{
+  setup_testMap();
+
+  // The const lookups match the cached lookups
+  TEST_ASSERT_TRUE(romMap.isXAxisUniform());
+  TEST_ASSERT_EQUAL(22.5, romMap.getValue(15, 15));
+  TEST_ASSERT_EQUAL(65, romMap.getValue(40, 40));
+  TEST_ASSERT_EQUAL(-1, romMap.getValue(10000, 35));
+  TEST_ASSERT_EQUAL(-1, romMap.getValue(25, -10));
+  for (int x = 10; x <= 40; x += 3) {
+    for (int y = 10; y <= 40; y += 7) {
+      TEST_ASSERT_FLOAT_WITHIN(0.0001, testMap.getValue(x, y), romMap.getValue(x, y));
+    }
+  }
+
+  // A (x, 1) sized table
+  constexpr Table<uint8_t, 5> romMap2d({0, 20, 40, 60, 80}, {20, 40, 80, 85, 90});
+  TEST_ASSERT_EQUAL(60, romMap2d.getValue(30));
+  TEST_ASSERT_EQUAL(90, romMap2d.getValue(80));
+  TEST_ASSERT_EQUAL(-1, romMap2d.getValue(81));
+}
+
+void test_lookupContext()
+{
+  setup_testMap();
+
+  // Interleaved consumers each keep their own cached result
+  Table<uint8_t, xSize, ySize>::LookupContext trim;
+  Table<uint8_t, xSize, ySize>::LookupContext logger;
+  for (int i = 0; i < 4; i++) {
+    TEST_ASSERT_EQUAL(22.5, romMap.getValue(15, 15, trim));
+    TEST_ASSERT_EQUAL(65, romMap.getValue(40, 40, logger));
+  }
+  TEST_ASSERT_EQUAL(3, trim.getResultCacheHits());
+  TEST_ASSERT_EQUAL(3, logger.getResultCacheHits());
+  TEST_ASSERT_EQUAL(0, logger.getBracketCacheMisses());
+  TEST_ASSERT_EQUAL(-1, romMap.getValue(10000, 35, trim));
+
+  // A context used with another table does not return its cached result
+  TEST_ASSERT_EQUAL(22.5, testMap.getValue(15, 15, trim));
+  TEST_ASSERT_EQUAL(3, trim.getResultCacheHits());
+
+  // Nor after the table is changed
+  testMap.setValueByIndex(0, 0, 45);
+  TEST_ASSERT_EQUAL(32.5, testMap.getValue(15, 15, trim));
+  testMap.setXAxisValueByIndex(0, 0);
+  TEST_ASSERT_EQUAL(35, testMap.getValue(15, 15, trim));
+  testMap.invalidateCache();
+  TEST_ASSERT_EQUAL(35, testMap.getValue(15, 15, trim));
+  TEST_ASSERT_EQUAL(3, trim.getResultCacheHits());
+  trim.resetStats();
+  TEST_ASSERT_EQUAL(0, trim.getBracketCacheHits() + trim.getBracketCacheMisses());
+
+  // The table's own cache is unaffected by the contexts
+  TEST_ASSERT_EQUAL(35, testMap.getValue(15, 15));
+}
+
+template<unsigned int CacheSize>
+unsigned long round_robin_hits()
+{
+  Table<uint8_t, xSize, ySize, int, int, double, TableRowMajor, CacheSize> map(
+    {10, 20, 30, 40}, {10, 20, 30, 40},
+    { 5, 10, 15, 20, 40, 35, 30, 25, 45, 50, 55, 60, 80, 75, 70, 65});
+  // Four cylinders read in turn, each with its own inputs
+  for (int cycle = 0; cycle < 3; cycle++) {
+    for (int cylinder = 0; cylinder < 4; cylinder++) {
+      TEST_ASSERT_EQUAL(romMap.getValue(15 + cylinder, 15 + cylinder), map.getValue(15 + cylinder, 15 + cylinder));
+    }
+  }
+  return map.getResultCacheHits();
+}
+
+void test_cacheSize()
+{
+  setup_testMap();
+
+  TEST_ASSERT_EQUAL(0, round_robin_hits<0>());
+  TEST_ASSERT_EQUAL(0, round_robin_hits<1>());
+  TEST_ASSERT_EQUAL(0, round_robin_hits<3>());
+  TEST_ASSERT_EQUAL(8, round_robin_hits<4>());
+  TEST_ASSERT_EQUAL(8, round_robin_hits<8>());
+
+  // Every edit invalidates the cached results
+  Table<uint8_t, xSize, ySize, int, int, double, TableRowMajor, 4> map;
+  map.initialise();
+  static char image[decltype(map)::getSize()];
+  TEST_ASSERT_TRUE(testMap.saveData(image, sizeof(image)));
+  TEST_ASSERT_TRUE(map.loadData(image, sizeof(image)));
+  TEST_ASSERT_EQUAL(22.5, map.getValue(15, 15));
+  TEST_ASSERT_EQUAL(65, map.getValue(40, 40));
+  TEST_ASSERT_TRUE(map.setValue(10, 10, 45));
+  TEST_ASSERT_EQUAL(32.5, map.getValue(15, 15));
+  TEST_ASSERT_TRUE(map.setValueByIndex(3, 3, 85));
+  TEST_ASSERT_EQUAL(85, map.getValue(40, 40));
+  TEST_ASSERT_TRUE(map.setXAxisValueByIndex(0, 0));
+  TEST_ASSERT_EQUAL(35, map.getValue(15, 15));
+  TEST_ASSERT_TRUE(map.setYAxisValueByIndex(0, 0));
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 31.875, map.getValue(15, 15));
+  TEST_ASSERT_TRUE(map.loadData(image, sizeof(image)));
+  TEST_ASSERT_EQUAL(22.5, map.getValue(15, 15));
+  TEST_ASSERT_EQUAL(65, map.getValue(40, 40));
+  TEST_ASSERT_EQUAL(0, map.getResultCacheHits());
+  TEST_ASSERT_EQUAL(65, map.getValue(40, 40));
+  TEST_ASSERT_EQUAL(1, map.getResultCacheHits());
+}
+
+template<typename Layout>
+void assert_bulkSetters()
+{
+  setup_testMap();
+  constexpr int axis[xSize] = {10, 20, 30, 40};
+  Table<uint8_t, xSize, ySize, int, int, double, Layout> map;
+  map.initialise();
+  TEST_ASSERT_TRUE(map.setXAxis(axis, xSize));
+  TEST_ASSERT_TRUE(map.setYAxis(axis, ySize));
+  TEST_ASSERT_TRUE(map.setColumn(0, tempRow1, xSize));
+  TEST_ASSERT_TRUE(map.setColumn(1, tempRow2, xSize));
+  TEST_ASSERT_TRUE(map.setColumn(2, tempRow3, xSize));
+  TEST_ASSERT_TRUE(map.setColumn(3, tempRow4, xSize));
+  for (int x = 10; x <= 40; x += 3) {
+    for (int y = 10; y <= 40; y += 3) { TEST_ASSERT_EQUAL_DOUBLE(testMap.getValue(x, y), map.getValue(x, y)); }
+  }
+
+  // Rows are the y values of one x index, planes the rows in turn
+  constexpr uint8_t row[ySize] = {1, 2, 3, 4};
+  TEST_ASSERT_TRUE(map.setRow(2, row, ySize));
+  for (unsigned int y = 0; y < ySize; y++) { TEST_ASSERT_EQUAL(row[y], map.getValueByIndex(2, y)); }
+  TEST_ASSERT_EQUAL(1.5, map.getValue(30, 15));
+  uint8_t plane[xSize * ySize];
+  for (unsigned int i = 0; i < xSize * ySize; i++) { plane[i] = i; }
+  TEST_ASSERT_TRUE(map.setPlane(plane, xSize * ySize));
+  TEST_ASSERT_EQUAL(6, map.getValueByIndex(1, 2));
+  TEST_ASSERT_EQUAL(15, map.getValue(40, 40));
+  map.fill(9);
+  TEST_ASSERT_EQUAL(9, map.getValue(15, 25));
+  TEST_ASSERT_EQUAL(9, map.getValueByIndex(3, 3));
+}
+
+void test_bulkSetters()
+{
+  assert_bulkSetters<TableRowMajor>();
+  assert_bulkSetters<TableColumnMajor>();
+  assert_bulkSetters<TableTiled<2>>();
+
+  // Wrong counts and unsorted axes are rejected, the table is unchanged
+  setup_testMap();
+  constexpr int unsorted[xSize] = {10, 30, 20, 40};
+  constexpr int repeated[xSize] = {10, 20, 20, 40};
+  constexpr int axis[xSize] = {0, 10, 20, 30};
+  constexpr uint8_t row[ySize] = {1, 2, 3, 4};
+  TEST_ASSERT_FALSE(testMap.setXAxis(unsorted, xSize));
+  TEST_ASSERT_FALSE(testMap.setYAxis(repeated, ySize));
+  TEST_ASSERT_FALSE(testMap.setXAxis(axis, xSize - 1));
+  TEST_ASSERT_FALSE(testMap.setRow(xSize, row, ySize));
+  TEST_ASSERT_FALSE(testMap.setRow(0, row, ySize - 1));
+  TEST_ASSERT_FALSE(testMap.setColumn(ySize, row, xSize));
+  TEST_ASSERT_FALSE(testMap.setPlane(row, ySize));
+  TEST_ASSERT_EQUAL(22.5, testMap.getValue(15, 15));
+
+  // A bulk edit invalidates the cached result once
+  TEST_ASSERT_EQUAL(22.5, testMap.getValue(15, 15));
+  TEST_ASSERT_TRUE(testMap.setXAxis(axis, xSize));
+  TEST_ASSERT_TRUE(testMap.isXAxisUniform());
+  TEST_ASSERT_EQUAL(42.5, testMap.getValue(15, 15));
+}
+
 void setUp (void) {}
 
 void tearDown (void) {}
@@ -7,6 +7,7 @@ void test_table_values(void);
 void test_tableLookup_50pct(void);
 void test_tableLookup_exact1Axis(void);
 void test_tableLookup_exact2Axis(void);
+void test_tableLookup_lastCell(void);
 void test_tableLookup_overMaxX(void);
 void test_tableLookup_overMaxY(void);
 void test_tableLookup_underMinX(void);
@@ -15,6 +16,16 @@ void test_all_incrementing(void);
 void test_setValue(void);
 void test_setValueNonDirect(void);
 void test_copyData(void);
+void test_bracketCache(void);
+void test_uniformAxis(void);
+void test_getValues(void);
+void test_getValueFixed(void);
+void test_getValueFixed16(void);
+void test_layouts(void);
+void test_constTable(void);
+void test_lookupContext(void);
+void test_cacheSize(void);
+void test_bulkSetters(void);
 
 constexpr unsigned int xSize = 4;
 constexpr unsigned int ySize = 4;
@@ -0,0 +1,85 @@
+#include "tests_table_cache.h"
+
+#include "Table.h"
+
+typedef Table<uint8_t, xSize, ySize> Map;
+
+// Constructed tables, both at their first revision
+const Map fuelMap(
+  {10, 20, 30, 40},
+  {10, 20, 30, 40},
+  { 5, 10, 15, 20,
+   40, 35, 30, 25,
+   45, 50, 55, 60,
+   80, 75, 70, 65});
+const Map emptyMap(
+  {10, 20, 30, 40},
+  {10, 20, 30, 40},
+  { 0,  0,  0,  0,
+    0,  0,  0,  0,
+    0,  0,  0,  0,
+    0,  0,  0,  0});
+
+void run_tests()
+{
+  UNITY_BEGIN(); // IMPORTANT LINE!
+  RUN_TEST(test_copyAssignment);
+  RUN_TEST(test_copyAssignmentEdited);
+  RUN_TEST(test_copyConstruction);
+  UNITY_END(); // stop unit testing
+}
+
+void test_copyAssignment(void)
+{
+  // A context holding a result of the assigned table does not return it after the assignment
+  Map map = emptyMap;
+  Map::LookupContext context;
+  TEST_ASSERT_EQUAL_DOUBLE(0, map.getValue(15, 15, context));
+  map = fuelMap;
+  TEST_ASSERT_EQUAL_DOUBLE(22.5, map.getValue(15, 15, context));
+  TEST_ASSERT_EQUAL_DOUBLE(22.5, map.getValue(15, 15));
+  TEST_ASSERT_EQUAL(0, context.getResultCacheHits());
+
+  // The copy caches again
+  TEST_ASSERT_EQUAL_DOUBLE(22.5, map.getValue(15, 15, context));
+  TEST_ASSERT_EQUAL(1, context.getResultCacheHits());
+}
+
+void test_copyAssignmentEdited(void)
+{
+  // The assigned table is at a later revision than the one copied
+  Map map = emptyMap;
+  map.setValueByIndex(0, 0, 1);
+  map.setValueByIndex(0, 0, 0);
+  Map::LookupContext context;
+  TEST_ASSERT_EQUAL_DOUBLE(0, map.getValue(15, 15, context));
+  Map source = fuelMap;
+  source.setValueByIndex(3, 3, 65);
+  map = source;
+  TEST_ASSERT_EQUAL_DOUBLE(22.5, map.getValue(15, 15, context));
+  TEST_ASSERT_EQUAL(0, context.getResultCacheHits());
+}
+
+void test_copyConstruction(void)
+{
+  // The table's own cache is copied with it and not used for the copy
+  Map source = emptyMap;
+  TEST_ASSERT_EQUAL_DOUBLE(0, source.getValue(15, 15));
+  Map copy(source);
+  TEST_ASSERT_EQUAL_DOUBLE(0, copy.getValue(15, 15));
+  TEST_ASSERT_EQUAL(0, copy.getResultCacheHits());
+  source = fuelMap;
+  Map second(source);
+  TEST_ASSERT_EQUAL_DOUBLE(22.5, second.getValue(15, 15));
+  TEST_ASSERT_EQUAL_DOUBLE(22.5, second.getValue(15, 15));
+  TEST_ASSERT_EQUAL(1, second.getResultCacheHits());
+}
+
+void setUp (void) {}
+
+void tearDown (void) {}
+
+int main(int argc, char **argv) {
+  run_tests();
+  return 0;
+}
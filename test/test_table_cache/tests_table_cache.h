@@ -0,0 +1,10 @@
+#include <unity.h>
+#include <cstdio>
+
+void run_tests();
+void test_copyAssignment(void);
+void test_copyAssignmentEdited(void);
+void test_copyConstruction(void);
+
+constexpr unsigned int xSize = 4;
+constexpr unsigned int ySize = 4;
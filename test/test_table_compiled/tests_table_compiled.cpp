@@ -0,0 +1,186 @@
+#include "tests_table_compiled.h"
+
+#include "CompiledTable.h"
+
+Table<uint16_t, xSize, ySize> testMap;
+CompiledTable<uint16_t, xSize, ySize> compiledMap;
+
+void setup_testMaps(void)
+{
+  // Uneven axes and values which are not a linear function of the indices
+  testMap.initialise();
+  compiledMap.initialise();
+  for (unsigned int x = 0; x < xSize; x++) {
+    testMap.setXAxisValueByIndex(x, tempXAxis[x]);
+    compiledMap.setXAxisValueByIndex(x, tempXAxis[x]);
+  }
+  for (unsigned int y = 0; y < ySize; y++) {
+    testMap.setYAxisValueByIndex(y, tempYAxis[y]);
+    compiledMap.setYAxisValueByIndex(y, tempYAxis[y]);
+  }
+  for (unsigned int x = 0; x < xSize; x++) {
+    for (unsigned int y = 0; y < ySize; y++) {
+      testMap.setValueByIndex(x, y, (x * 37 + y * 11 + x * y * 5) % 200);
+      compiledMap.setValueByIndex(x, y, (x * 37 + y * 11 + x * y * 5) % 200);
+    }
+  }
+}
+
+/**
+ * Compares the compiled lookups, cached and const, with the Table over the whole table.
+ */
+void assert_matches(void)
+{
+  const CompiledTable<uint16_t, xSize, ySize>& constMap = compiledMap;
+  for (int x = 0; x <= 6000; x += 97) {
+    for (int y = 10; y <= 100; y += 3) {
+      TEST_ASSERT_FLOAT_WITHIN(1e-9, testMap.getValue(x, y), compiledMap.getValue(x, y));
+      TEST_ASSERT_FLOAT_WITHIN(1e-9, testMap.getValue(x, y), constMap.getValue(x, y));
+    }
+  }
+}
+
+void run_tests()
+{
+  UNITY_BEGIN(); // IMPORTANT LINE!
+  RUN_TEST(test_matchesTable);
+  RUN_TEST(test_outOfBounds);
+  RUN_TEST(test_setValueByIndex);
+  RUN_TEST(test_setAxis);
+  RUN_TEST(test_loadData);
+  RUN_TEST(test_table2d);
+  RUN_TEST(test_bulkSetters);
+  UNITY_END(); // stop unit testing
+}
+
+void test_matchesTable(void)
+{
+  setup_testMaps();
+  assert_matches();
+
+  // Breakpoints are exact
+  for (unsigned int x = 0; x < xSize; x++) {
+    for (unsigned int y = 0; y < ySize; y++) {
+      TEST_ASSERT_EQUAL(testMap.getValueByIndex(x, y), compiledMap.getValue(tempXAxis[x], tempYAxis[y]));
+    }
+  }
+}
+
+void test_outOfBounds(void)
+{
+  setup_testMaps();
+  TEST_ASSERT_EQUAL(-1, compiledMap.getValue(-1, 50));
+  TEST_ASSERT_EQUAL(-1, compiledMap.getValue(6001, 50));
+  TEST_ASSERT_EQUAL(-1, compiledMap.getValue(100, 9));
+  TEST_ASSERT_EQUAL(-1, compiledMap.getValue(100, 101));
+}
+
+void test_setValueByIndex(void)
+{
+  setup_testMaps();
+
+  // Only the cells around the value are rebuilt, the rest stay valid
+  const unsigned int edits[][2] = {{0, 0}, {2, 3}, {5, 4}, {5, 0}, {3, 1}};
+  for (auto& edit : edits) {
+    testMap.setValueByIndex(edit[0], edit[1], 250);
+    compiledMap.setValueByIndex(edit[0], edit[1], 250);
+    assert_matches();
+  }
+  TEST_ASSERT_TRUE(compiledMap.setValue(1200, 70, 3));
+  TEST_ASSERT_TRUE(testMap.setValue(1200, 70, 3));
+  assert_matches();
+  TEST_ASSERT_FALSE(compiledMap.setValue(1201, 70, 3));
+  TEST_ASSERT_FALSE(compiledMap.setValueByIndex(xSize, 0, 3));
+}
+
+void test_setAxis(void)
+{
+  setup_testMaps();
+  testMap.setXAxisValueByIndex(2, 1500);
+  compiledMap.setXAxisValueByIndex(2, 1500);
+  assert_matches();
+  testMap.setXAxisValueByIndex(5, 6500);
+  compiledMap.setXAxisValueByIndex(5, 6500);
+  assert_matches();
+  testMap.setYAxisValueByIndex(0, 0);
+  compiledMap.setYAxisValueByIndex(0, 0);
+  assert_matches();
+  testMap.setYAxisValueByIndex(3, 60);
+  compiledMap.setYAxisValueByIndex(3, 60);
+  assert_matches();
+  TEST_ASSERT_FALSE(compiledMap.setYAxisValueByIndex(ySize, 0));
+}
+
+void test_loadData(void)
+{
+  setup_testMaps();
+  static char image[decltype(testMap)::getSize()];
+  testMap.setValueByIndex(1, 1, 199);
+  testMap.setXAxisValueByIndex(5, 7000);
+  TEST_ASSERT_TRUE(testMap.saveData(image, sizeof(image)));
+  TEST_ASSERT_TRUE(compiledMap.loadData(image, sizeof(image)));
+  assert_matches();
+  TEST_ASSERT_TRUE(compiledMap.saveData(image, sizeof(image)));
+  TEST_ASSERT_TRUE(testMap.loadData(image, sizeof(image)));
+  assert_matches();
+}
+
+void test_table2d(void)
+{
+  Table<uint8_t, 5> table;
+  CompiledTable<uint8_t, 5> compiled;
+  table.initialise();
+  compiled.initialise();
+  const int axis[5] = {0, 20, 40, 60, 80};
+  const uint8_t data[5] = {20, 40, 80, 85, 90};
+  for (unsigned int x = 0; x < 5; x++) {
+    table.setXAxisValueByIndex(x, axis[x]);
+    compiled.setXAxisValueByIndex(x, axis[x]);
+    table.setValueByIndex(x, data[x]);
+    compiled.setValueByIndex(x, data[x]);
+  }
+  for (int x = 0; x <= 80; x++) {
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, table.getValue(x), compiled.getValue(x));
+  }
+  TEST_ASSERT_EQUAL(-1, compiled.getValue(81));
+}
+
+void test_bulkSetters(void)
+{
+  setup_testMaps();
+  const uint16_t row[ySize] = {1, 50, 9, 120, 3};
+  const uint16_t column[xSize] = {7, 190, 4, 60, 33, 100};
+  TEST_ASSERT_TRUE(testMap.setRow(3, row, ySize));
+  TEST_ASSERT_TRUE(compiledMap.setRow(3, row, ySize));
+  assert_matches();
+  TEST_ASSERT_TRUE(testMap.setColumn(0, column, xSize));
+  TEST_ASSERT_TRUE(compiledMap.setColumn(0, column, xSize));
+  assert_matches();
+  const int xAxis[xSize] = {0, 100, 900, 2500, 4000, 6000};
+  TEST_ASSERT_TRUE(testMap.setXAxis(xAxis, xSize));
+  TEST_ASSERT_TRUE(compiledMap.setXAxis(xAxis, xSize));
+  assert_matches();
+  const int yAxis[ySize] = {10, 30, 50, 60, 100};
+  TEST_ASSERT_TRUE(testMap.setYAxis(yAxis, ySize));
+  TEST_ASSERT_TRUE(compiledMap.setYAxis(yAxis, ySize));
+  assert_matches();
+  uint16_t plane[xSize * ySize];
+  for (unsigned int i = 0; i < xSize * ySize; i++) { plane[i] = (i * 53) % 170; }
+  TEST_ASSERT_TRUE(testMap.setPlane(plane, xSize * ySize));
+  TEST_ASSERT_TRUE(compiledMap.setPlane(plane, xSize * ySize));
+  assert_matches();
+  compiledMap.fill(42);
+  TEST_ASSERT_EQUAL_DOUBLE(42, compiledMap.getValue(1234, 56));
+  const int unsorted[xSize] = {0, 100, 90, 2500, 4000, 6000};
+  TEST_ASSERT_FALSE(compiledMap.setXAxis(unsorted, xSize));
+  TEST_ASSERT_FALSE(compiledMap.setRow(0, row, ySize - 1));
+}
+
+void setUp (void) {}
+
+void tearDown (void) {}
+
+int main(int argc, char **argv) {
+  run_tests();
+  return 0;
+}
@@ -0,0 +1,17 @@
+#include <unity.h>
+#include <cstdio>
+
+void run_tests();
+void test_matchesTable(void);
+void test_outOfBounds(void);
+void test_setValueByIndex(void);
+void test_setAxis(void);
+void test_loadData(void);
+void test_table2d(void);
+void test_bulkSetters(void);
+
+constexpr unsigned int xSize = 6;
+constexpr unsigned int ySize = 5;
+
+constexpr int tempXAxis[xSize] = {0, 500, 1200, 2000, 3500, 6000};
+constexpr int tempYAxis[ySize] = {10, 20, 45, 70, 100};
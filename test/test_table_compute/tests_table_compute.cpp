@@ -0,0 +1,122 @@
+#include "tests_table_compute.h"
+
+#include "Table.h"
+
+#include <type_traits>
+
+/**
+ * The same lookups for each compute type of the Table.
+ */
+
+template<typename ComputeT>
+void setup_testMap(Table<uint8_t, xSize, ySize, int, int, ComputeT>& testMap)
+{
+  //Table is setup per the below
+  /*
+  40  |   20 |   25 |   60 |   65
+  30  |   15 |   30 |   55 |   70
+  20  |   10 |   35 |   50 |   75
+  10  |    5 |   40 |   45 |   80
+      ----------------------------
+          10 |   20 |   30 |   40
+  */
+  testMap.initialise();
+
+  constexpr int tempXAxis[xSize] = {10, 20, 30, 40};
+  for (unsigned int x = 0; x < xSize; x++) { testMap.setXAxisValueByIndex(x, tempXAxis[x]); }
+  constexpr int tempYAxis[ySize] = {10, 20, 30, 40};
+  for (unsigned int y = 0; y < ySize; y++) { testMap.setYAxisValueByIndex(y, tempYAxis[y]); }
+
+  for (unsigned int x = 0; x < xSize; x++) { testMap.setValueByIndex(x, 0, tempRow1[x]); }
+  for (unsigned int x = 0; x < xSize; x++) { testMap.setValueByIndex(x, 1, tempRow2[x]); }
+  for (unsigned int x = 0; x < xSize; x++) { testMap.setValueByIndex(x, 2, tempRow3[x]); }
+  for (unsigned int x = 0; x < xSize; x++) { testMap.setValueByIndex(x, 3, tempRow4[x]); }
+}
+
+template<typename ComputeT>
+void test_lookups()
+{
+  Table<uint8_t, xSize, ySize, int, int, ComputeT> testMap;
+  setup_testMap(testMap);
+
+  static_assert(std::is_same<decltype(testMap.getValue(0, 0)), ComputeT>::value, "getValue returns the compute type");
+
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 22.5, testMap.getValue(15, 15));
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 7.5, testMap.getValue(10, 15));
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 62.5, testMap.getValue(35, 30));
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 35, testMap.getValue(20, 20));
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 65, testMap.getValue(40, 40));
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 19.3, testMap.getValue(11, 37));
+  TEST_ASSERT_EQUAL(-1, testMap.getValue(10000, 35));
+  TEST_ASSERT_EQUAL(-1, testMap.getValue(25, -10));
+
+  // Cached result
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 19.3, testMap.getValue(11, 37));
+}
+
+template<typename ComputeT>
+void test_lookups2d()
+{
+  Table<uint8_t, 5, 1, int, int, ComputeT> testMap;
+  testMap.initialise();
+
+  constexpr int tempXAxis[5] = {0, 20, 40, 60, 80};
+  constexpr uint8_t tempValues[5] = {20, 40, 80, 85, 90};
+  for (unsigned int x = 0; x < 5; x++) { testMap.setXAxisValueByIndex(x, tempXAxis[x]); }
+  for (unsigned int x = 0; x < 5; x++) { testMap.setValueByIndex(x, tempValues[x]); }
+
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 60, testMap.getValue(30));
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 40, testMap.getValue(20));
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 89.75, testMap.getValue(79));
+  TEST_ASSERT_EQUAL(-1, testMap.getValue(10000));
+}
+
+template<typename ComputeT>
+void test_getValues()
+{
+  Table<uint8_t, xSize, ySize, int, int, ComputeT> testMap;
+  setup_testMap(testMap);
+
+  // A batch of mixed rows and columns, checked value by value against getValue
+  constexpr unsigned int count = 37;
+  int x_axis[count];
+  int y_axis[count];
+  ComputeT values[count];
+  for (unsigned int i = 0; i < count; i++) {
+    x_axis[i] = 9 + i;
+    y_axis[i] = 41 - i;
+  }
+  testMap.getValues(x_axis, y_axis, values, count);
+
+  for (unsigned int i = 0; i < count; i++) {
+    TEST_ASSERT_FLOAT_WITHIN(0.0001, testMap.getValue(x_axis[i], y_axis[i]), values[i]);
+  }
+}
+
+void test_lookups_double(void) { test_lookups<double>(); }
+void test_lookups_float(void) { test_lookups<float>(); }
+void test_lookups2d_double(void) { test_lookups2d<double>(); }
+void test_lookups2d_float(void) { test_lookups2d<float>(); }
+void test_getValues_double(void) { test_getValues<double>(); }
+void test_getValues_float(void) { test_getValues<float>(); }
+
+void run_tests()
+{
+  UNITY_BEGIN(); // IMPORTANT LINE!
+  RUN_TEST(test_lookups_double);
+  RUN_TEST(test_lookups_float);
+  RUN_TEST(test_lookups2d_double);
+  RUN_TEST(test_lookups2d_float);
+  RUN_TEST(test_getValues_double);
+  RUN_TEST(test_getValues_float);
+  UNITY_END(); // stop unit testing
+}
+
+void setUp (void) {}
+
+void tearDown (void) {}
+
+int main(int argc, char **argv) {
+  run_tests();
+  return 0;
+}
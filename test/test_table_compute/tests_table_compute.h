@@ -0,0 +1,18 @@
+#include <unity.h>
+#include <cstdio>
+
+void run_tests();
+void test_lookups_double(void);
+void test_lookups_float(void);
+void test_lookups2d_double(void);
+void test_lookups2d_float(void);
+void test_getValues_double(void);
+void test_getValues_float(void);
+
+constexpr unsigned int xSize = 4;
+constexpr unsigned int ySize = 4;
+
+constexpr uint8_t tempRow4[xSize] = {20, 25, 60, 65};
+constexpr uint8_t tempRow3[xSize] = {15, 30, 55, 70};
+constexpr uint8_t tempRow2[xSize] = {10, 35, 50, 75};
+constexpr uint8_t tempRow1[xSize] = {5, 40, 45, 80};
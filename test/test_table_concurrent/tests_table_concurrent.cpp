@@ -0,0 +1,148 @@
+#include "tests_table_concurrent.h"
+
+#include "ConcurrentTable.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+typedef ConcurrentTable<uint32_t, xSize, ySize> TestTable;
+
+/**
+ * Stages generation g: cell (x, y) holds g * 1000 + x * 10 + y, and the x axis
+ * spacing changes with the generation. The centre of any cell of one generation
+ * interpolates to g * 1000 + x * 10 + y + 5.5, a torn read gives another fraction.
+ */
+void stage_generation(TestTable& table, unsigned int g)
+{
+  TestTable::TableType& staged = table.stage();
+  for (unsigned int x = 0; x < xSize; x++) { staged.setXAxisValueByIndex(x, x * (10 + 10 * (g % 3))); }
+  for (unsigned int y = 0; y < ySize; y++) { staged.setYAxisValueByIndex(y, y * 10); }
+  for (unsigned int x = 0; x < xSize; x++) {
+    for (unsigned int y = 0; y < ySize; y++) { staged.setValueByIndex(x, y, g * 1000 + x * 10 + y); }
+  }
+}
+
+void run_tests()
+{
+  UNITY_BEGIN(); // IMPORTANT LINE!
+  RUN_TEST(test_publish);
+  RUN_TEST(test_stagedEdits);
+  RUN_TEST(test_stress);
+  RUN_TEST(test_setValueByIndexInvalidatesCache);
+  UNITY_END(); // stop unit testing
+}
+
+void test_publish(void)
+{
+  TestTable table;
+  stage_generation(table, 1);
+  TEST_ASSERT_EQUAL(-1, table.getValue(5, 5));
+  table.publish();
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 1005.5, table.getValue(10, 5));
+  TEST_ASSERT_EQUAL(1, table.getPublishCount());
+}
+
+void test_stagedEdits(void)
+{
+  TestTable table;
+  stage_generation(table, 1);
+  table.publish();
+
+  // Staged edits are not seen until published
+  table.stage().setValueByIndex(0, 0, 7);
+  table.stage().setXAxisValueByIndex(xSize - 1, 1000);
+  TEST_ASSERT_EQUAL(1000, table.getValue(0, 0));
+  TEST_ASSERT_EQUAL(-1, table.getValue(1000, 0));
+  table.publish();
+  TEST_ASSERT_EQUAL(7, table.getValue(0, 0));
+  TEST_ASSERT_EQUAL(1070, table.getValue(1000, 0));
+
+  // Both copies hold the edits after publishing
+  table.publish();
+  TEST_ASSERT_EQUAL(7, table.getValue(0, 0));
+}
+
+void test_stress(void)
+{
+  TestTable table;
+  stage_generation(table, 0);
+  table.publish();
+
+  const unsigned int readerCount = std::thread::hardware_concurrency() > 2 ? std::thread::hardware_concurrency() - 1 : 2;
+  const auto duration = std::chrono::milliseconds(300);
+  std::atomic<bool> running{true};
+  std::atomic<unsigned long> reads{0};
+  std::atomic<unsigned long> errors{0};
+
+  std::vector<std::thread> readers;
+  for (unsigned int r = 0; r < readerCount; r++) {
+    readers.emplace_back([&, r]() {
+      unsigned long count = 0;
+      unsigned long bad = 0;
+      double lastGeneration = 0;
+      unsigned int seed = r + 1;
+      while (running.load(std::memory_order_relaxed)) {
+        seed = seed * 1664525 + 1013904223;
+        const unsigned int x = (seed >> 8) % (xSize - 1);
+        const unsigned int y = (seed >> 16) % (ySize - 1);
+        // Centre of cell (x, y), found from the published x axis spacing
+        const double value = table.read([&](const TestTable::TableType& t) {
+          const int step = t.getValue(0, 0) >= 0 ? static_cast<int>((static_cast<unsigned int>(t.getValueByIndex(0, 0)) / 1000) % 3) : 0;
+          const int width = 10 + 10 * step;
+          return t.getValue(x * width + width / 2, y * 10 + 5);
+        });
+        const double generation = std::floor(value / 1000);
+        const double cell = value - generation * 1000;
+        if (std::fabs(cell - (x * 10 + y + 5.5)) > 0.001 || generation < lastGeneration) bad++;
+        lastGeneration = generation;
+        count++;
+      }
+      reads += count;
+      errors += bad;
+    });
+  }
+
+  // Writer publishes new generations as fast as it can
+  auto start = std::chrono::steady_clock::now();
+  unsigned int generation = 0;
+  while (std::chrono::steady_clock::now() - start < duration) {
+    stage_generation(table, ++generation);
+    table.publish();
+  }
+  running = false;
+  for (auto& reader : readers) reader.join();
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  char message[128];
+  snprintf(message, sizeof(message), "%u readers: %.0f reads/s, %.0f publishes/s",
+           readerCount, reads.load() / seconds, generation / seconds);
+  TEST_MESSAGE(message);
+
+  TEST_ASSERT_EQUAL(0, errors.load());
+  TEST_ASSERT_TRUE(reads.load() > 0);
+  TEST_ASSERT_TRUE(generation > 0);
+}
+
+void test_setValueByIndexInvalidatesCache(void)
+{
+  // The cached getValue does not return a stale result after an edit
+  Table<uint8_t, 2, 2> map({0, 10}, {0, 10}, {0, 10, 20, 30});
+  TEST_ASSERT_EQUAL(15, map.getValue(5, 5));
+  map.setValueByIndex(0, 0, 40);
+  TEST_ASSERT_EQUAL(25, map.getValue(5, 5));
+  TEST_ASSERT_EQUAL(20, map.getValue(10, 0));
+  map.setXAxisValueByIndex(1, 20);
+  TEST_ASSERT_EQUAL(30, map.getValue(10, 0));
+}
+
+void setUp (void) {}
+
+void tearDown (void) {}
+
+int main(int argc, char **argv) {
+  run_tests();
+  return 0;
+}
@@ -0,0 +1,11 @@
+#include <unity.h>
+#include <cstdio>
+
+void run_tests();
+void test_publish(void);
+void test_stagedEdits(void);
+void test_stress(void);
+void test_setValueByIndexInvalidatesCache(void);
+
+constexpr unsigned int xSize = 8;
+constexpr unsigned int ySize = 8;
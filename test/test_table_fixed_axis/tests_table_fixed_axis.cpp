@@ -0,0 +1,168 @@
+#include "tests_table_fixed_axis.h"
+
+#include "FixedAxisTable.h"
+
+typedef FixedTableAxis<int, 500, 1000, 2000, 3500, 5000, 6500, 7000> RpmAxis;
+typedef FixedTableAxis<int, 20, 40, 60, 80, 100> MapAxis;
+typedef FixedAxisTable<uint8_t, RpmAxis, MapAxis> FixedMap;
+
+constexpr unsigned int xSize = RpmAxis::size;
+constexpr unsigned int ySize = MapAxis::size;
+constexpr int xAxis[xSize] = {500, 1000, 2000, 3500, 5000, 6500, 7000};
+constexpr int yAxis[ySize] = {20, 40, 60, 80, 100};
+
+uint8_t mapValue(unsigned int x, unsigned int y)
+{
+  return (x * 37 + y * 11 + x * y * 5) % 250;
+}
+
+void setup_testMaps(FixedMap& fixed, Table<uint8_t, xSize, ySize>& table)
+{
+  fixed.initialise();
+  table.initialise();
+  for (unsigned int x = 0; x < xSize; x++) { table.setXAxisValueByIndex(x, xAxis[x]); }
+  for (unsigned int y = 0; y < ySize; y++) { table.setYAxisValueByIndex(y, yAxis[y]); }
+  for (unsigned int x = 0; x < xSize; x++) {
+    for (unsigned int y = 0; y < ySize; y++) {
+      fixed.setValueByIndex(x, y, mapValue(x, y));
+      table.setValueByIndex(x, y, mapValue(x, y));
+    }
+  }
+}
+
+void run_tests()
+{
+  UNITY_BEGIN(); // IMPORTANT LINE!
+  RUN_TEST(test_matchesTable);
+  RUN_TEST(test_breakpointsExact);
+  RUN_TEST(test_singleAxis);
+  RUN_TEST(test_outOfBounds);
+  RUN_TEST(test_valuesOnly);
+  RUN_TEST(test_imageCompatible);
+  UNITY_END(); // stop unit testing
+}
+
+void test_matchesTable(void)
+{
+  FixedMap fixed;
+  Table<uint8_t, xSize, ySize> table;
+  setup_testMaps(fixed, table);
+
+  for (int x = 500; x <= 7000; x += 15) {
+    for (int y = 20; y <= 100; y++) {
+      TEST_ASSERT_DOUBLE_WITHIN(1e-9, table.getValue(x, y), fixed.getValue(x, y));
+    }
+  }
+
+  int X_in[4] = {500, 1234, 6999, 7000};
+  int Y_in[4] = {20, 57, 99, 100};
+  double out[4];
+  fixed.getValues(X_in, Y_in, out, 4);
+  for (unsigned int i = 0; i < 4; i++) {
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, table.getValue(X_in[i], Y_in[i]), out[i]);
+  }
+}
+
+void test_breakpointsExact(void)
+{
+  FixedMap fixed;
+  Table<uint8_t, xSize, ySize> table;
+  setup_testMaps(fixed, table);
+
+  for (unsigned int x = 0; x < xSize; x++) {
+    for (unsigned int y = 0; y < ySize; y++) {
+      TEST_ASSERT_EQUAL_DOUBLE(mapValue(x, y), fixed.getValue(xAxis[x], yAxis[y]));
+    }
+  }
+  TEST_ASSERT_EQUAL(3500, FixedMap::getXAxisValueByIndex(3));
+  TEST_ASSERT_EQUAL(100, FixedMap::getYAxisValueByIndex(4));
+}
+
+void test_singleAxis(void)
+{
+  typedef FixedTableAxis<int, 0, 30, 100> TempAxis;
+  constexpr uint8_t data[3] = {10, 40, 180};
+  const FixedAxisTable<uint8_t, TempAxis> fixed(data);
+  Table<uint8_t, 3> table({0, 30, 100}, data);
+
+  for (int x = 0; x <= 100; x++) {
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, table.getValue(x), fixed.getValue(x));
+  }
+  TEST_ASSERT_EQUAL_DOUBLE(180, fixed.getValue(100));
+
+  typedef FixedTableAxis<int, 7> PointAxis;
+  FixedAxisTable<float, PointAxis, PointAxis> point;
+  point.setValueByIndex(0, 0, 2.5f);
+  TEST_ASSERT_EQUAL_DOUBLE(2.5, point.getValue(7, 7));
+  TEST_ASSERT_EQUAL_DOUBLE(-1, point.getValue(8, 7));
+}
+
+void test_outOfBounds(void)
+{
+  FixedMap fixed;
+  Table<uint8_t, xSize, ySize> table;
+  setup_testMaps(fixed, table);
+
+  TEST_ASSERT_EQUAL_DOUBLE(-1, fixed.getValue(499, 60));
+  TEST_ASSERT_EQUAL_DOUBLE(-1, fixed.getValue(7001, 60));
+  TEST_ASSERT_EQUAL_DOUBLE(-1, fixed.getValue(1000, 19));
+  TEST_ASSERT_EQUAL_DOUBLE(-1, fixed.getValue(1000, 101));
+  TEST_ASSERT_FALSE(fixed.setValueByIndex(xSize, 0, 1));
+  TEST_ASSERT_FALSE(fixed.setValueByIndex(0, ySize, 1));
+}
+
+void test_valuesOnly(void)
+{
+  // The breakpoints are part of the type, only the values are stored
+  TEST_ASSERT_EQUAL(xSize * ySize * sizeof(uint8_t), sizeof(FixedMap));
+  TEST_ASSERT_TRUE(sizeof(FixedMap) < sizeof(Table<uint8_t, xSize, ySize>));
+
+  FixedMap fixed;
+  uint8_t plane[xSize * ySize];
+  for (unsigned int i = 0; i < xSize * ySize; i++) { plane[i] = i; }
+  TEST_ASSERT_TRUE(fixed.setPlane(plane, xSize * ySize));
+  TEST_ASSERT_FALSE(fixed.setPlane(plane, xSize));
+  TEST_ASSERT_EQUAL(2 * ySize + 3, fixed.getValueByIndex(2, 3));
+  fixed.fill(9);
+  TEST_ASSERT_EQUAL_DOUBLE(9, fixed.getValue(4321, 77));
+}
+
+void test_imageCompatible(void)
+{
+  FixedMap fixed;
+  Table<uint8_t, xSize, ySize> table;
+  setup_testMaps(fixed, table);
+
+  char image[FixedMap::getSize()];
+  TEST_ASSERT_EQUAL(table.getSize(), FixedMap::getSize());
+
+  // A Table image with the same axes loads
+  TEST_ASSERT_TRUE(table.saveData(image, sizeof(image)));
+  FixedMap loaded;
+  TEST_ASSERT_TRUE(loaded.loadData(image, sizeof(image)));
+  TEST_ASSERT_EQUAL_DOUBLE(table.getValue(2750, 45), loaded.getValue(2750, 45));
+
+  // and a saved image loads into a Table
+  Table<uint8_t, xSize, ySize> copy;
+  TEST_ASSERT_TRUE(fixed.saveData(image, sizeof(image)));
+  TEST_ASSERT_TRUE(copy.loadData(image, sizeof(image)));
+  TEST_ASSERT_EQUAL_DOUBLE(mapValue(4, 0), copy.getValue(5000, 20));
+  TEST_ASSERT_EQUAL_DOUBLE(fixed.getValue(6100, 33), copy.getValue(6100, 33));
+
+  // A Table image with other axes is rejected
+  table.setXAxisValueByIndex(3, 3600);
+  TEST_ASSERT_TRUE(table.saveData(image, sizeof(image)));
+  loaded.fill(1);
+  TEST_ASSERT_FALSE(loaded.loadData(image, sizeof(image)));
+  TEST_ASSERT_EQUAL(1, loaded.getValueByIndex(0, 0));
+  TEST_ASSERT_FALSE(fixed.saveData(image, sizeof(image) - 1));
+}
+
+void setUp (void) {}
+
+void tearDown (void) {}
+
+int main(int argc, char **argv) {
+  run_tests();
+  return 0;
+}
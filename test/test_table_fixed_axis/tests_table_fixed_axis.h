@@ -0,0 +1,10 @@
+#include <unity.h>
+#include <cstdio>
+
+void run_tests();
+void test_matchesTable(void);
+void test_breakpointsExact(void);
+void test_singleAxis(void);
+void test_outOfBounds(void);
+void test_valuesOnly(void);
+void test_imageCompatible(void);
@@ -0,0 +1,126 @@
+#include "tests_table_gradient.h"
+
+#include "Table.h"
+
+// Long axes, so the finite differences are taken over fractions of a segment
+Table<uint16_t, xSize, ySize, long, long> testMap;
+
+void setup_testMap(void)
+{
+  testMap.initialise();
+  TEST_ASSERT_TRUE(testMap.setXAxis(tempXAxis, xSize));
+  TEST_ASSERT_TRUE(testMap.setYAxis(tempYAxis, ySize));
+  for (unsigned int x = 0; x < xSize; x++) {
+    for (unsigned int y = 0; y < ySize; y++) { testMap.setValueByIndex(x, y, (x * 37 + y * 11 + x * y * 5) % 200); }
+  }
+}
+
+void run_tests()
+{
+  UNITY_BEGIN(); // IMPORTANT LINE!
+  RUN_TEST(test_value);
+  RUN_TEST(test_finiteDifferences);
+  RUN_TEST(test_breakpoints);
+  RUN_TEST(test_constLookup);
+  RUN_TEST(test_outOfBounds);
+  RUN_TEST(test_table2d);
+  UNITY_END(); // stop unit testing
+}
+
+void test_value(void)
+{
+  setup_testMap();
+  const Table<uint16_t, xSize, ySize, long, long>& constMap = testMap;
+  double dX = 0;
+  double dY = 0;
+  for (long x = 0; x <= 6000; x += 37) {
+    for (long y = 10; y <= 100; y += 3) {
+      TEST_ASSERT_DOUBLE_WITHIN(1e-9, constMap.getValue(x, y), testMap.getValueAndGradient(x, y, dX, dY));
+    }
+  }
+}
+
+void test_finiteDifferences(void)
+{
+  setup_testMap();
+  double dX = 0;
+  double dY = 0;
+  // Central differences within a cell, where the table is bilinear and the difference is exact
+  const long points[][2] = {{250, 15}, {800, 30}, {1700, 60}, {2600, 85}, {5000, 40}, {1201, 44}};
+  for (auto& p : points) {
+    const long x = p[0];
+    const long y = p[1];
+    testMap.getValueAndGradient(x, y, dX, dY);
+    const double fdX = (testMap.getValue(x + 1, y) - testMap.getValue(x - 1, y)) / 2;
+    const double fdY = (testMap.getValue(x, y + 1) - testMap.getValue(x, y - 1)) / 2;
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, fdX, dX);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, fdY, dY);
+  }
+}
+
+void test_breakpoints(void)
+{
+  setup_testMap();
+  double dX = 0;
+  double dY = 0;
+  // The gradient of the cell above the breakpoint, a forward difference
+  testMap.getValueAndGradient(1200, 45, dX, dY);
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, testMap.getValue(1201, 45) - testMap.getValue(1200, 45), dX);
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, testMap.getValue(1200, 46) - testMap.getValue(1200, 45), dY);
+  // Approached from below, the bracket cache holds the lower cell
+  testMap.getValueAndGradient(1100, 40, dX, dY);
+  testMap.getValueAndGradient(1200, 45, dX, dY);
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, testMap.getValue(1201, 45) - testMap.getValue(1200, 45), dX);
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, testMap.getValue(1200, 46) - testMap.getValue(1200, 45), dY);
+  // The last breakpoints take the last cell, a backward difference
+  testMap.getValueAndGradient(6000, 100, dX, dY);
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, testMap.getValue(6000, 100) - testMap.getValue(5999, 100), dX);
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, testMap.getValue(6000, 100) - testMap.getValue(6000, 99), dY);
+}
+
+void test_constLookup(void)
+{
+  setup_testMap();
+  const Table<uint16_t, xSize, ySize, long, long>& constMap = testMap;
+  double dX = 0;
+  double dY = 0;
+  double cX = 0;
+  double cY = 0;
+  for (long x = 0; x <= 6000; x += 250) {
+    for (long y = 10; y <= 100; y += 5) {
+      TEST_ASSERT_EQUAL_DOUBLE(testMap.getValueAndGradient(x, y, dX, dY), constMap.getValueAndGradient(x, y, cX, cY));
+      TEST_ASSERT_EQUAL_DOUBLE(dX, cX);
+      TEST_ASSERT_EQUAL_DOUBLE(dY, cY);
+    }
+  }
+}
+
+void test_outOfBounds(void)
+{
+  setup_testMap();
+  double dX = 1;
+  double dY = 1;
+  TEST_ASSERT_EQUAL_DOUBLE(-1, testMap.getValueAndGradient(6001, 50, dX, dY));
+  TEST_ASSERT_EQUAL_DOUBLE(0, dX);
+  TEST_ASSERT_EQUAL_DOUBLE(0, dY);
+  TEST_ASSERT_EQUAL_DOUBLE(-1, testMap.getValueAndGradient(3000, 9, dX, dY));
+}
+
+void test_table2d(void)
+{
+  Table<uint8_t, 4> curve({0, 100, 200, 300}, {0, 20, 80, 90});
+  double dX = 0;
+  TEST_ASSERT_EQUAL_DOUBLE(50, curve.getValueAndGradient(150, dX));
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, 0.6, dX);
+  TEST_ASSERT_EQUAL_DOUBLE(90, curve.getValueAndGradient(300, dX));
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, 0.1, dX);
+}
+
+void setUp (void) {}
+
+void tearDown (void) {}
+
+int main(int argc, char **argv) {
+  run_tests();
+  return 0;
+}
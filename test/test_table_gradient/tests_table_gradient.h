@@ -0,0 +1,16 @@
+#include <unity.h>
+#include <cstdio>
+
+void run_tests();
+void test_value(void);
+void test_finiteDifferences(void);
+void test_breakpoints(void);
+void test_constLookup(void);
+void test_outOfBounds(void);
+void test_table2d(void);
+
+constexpr unsigned int xSize = 6;
+constexpr unsigned int ySize = 5;
+
+constexpr long tempXAxis[xSize] = {0, 500, 1200, 2000, 3500, 6000};
+constexpr long tempYAxis[ySize] = {10, 20, 45, 70, 100};
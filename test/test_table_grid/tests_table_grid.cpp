@@ -0,0 +1,151 @@
+#include "tests_table_grid.h"
+
+#include "TableGrid.h"
+
+Table<uint16_t, xSize, ySize> testMap;
+
+void setup_testMap(void)
+{
+  testMap.initialise();
+  testMap.setXAxis(tempXAxis, xSize);
+  testMap.setYAxis(tempYAxis, ySize);
+  for (unsigned int x = 0; x < xSize; x++) {
+    for (unsigned int y = 0; y < ySize; y++) { testMap.setValueByIndex(x, y, (x * 37 + y * 11 + x * y * 5) % 200); }
+  }
+}
+
+/**
+ * Compares a grid with getValue at each of its points.
+ */
+void assert_grid(const int* X_in, unsigned int xCount, const int* Y_in, unsigned int yCount, const double* grid)
+{
+  const Table<uint16_t, xSize, ySize>& constMap = testMap;
+  for (unsigned int i = 0; i < xCount; i++) {
+    for (unsigned int j = 0; j < yCount; j++) {
+      TEST_ASSERT_DOUBLE_WITHIN(1e-9, constMap.getValue(X_in[i], Y_in[j]), grid[i * yCount + j]);
+    }
+  }
+}
+
+void run_tests()
+{
+  UNITY_BEGIN(); // IMPORTANT LINE!
+  RUN_TEST(test_evaluate);
+  RUN_TEST(test_threads);
+  RUN_TEST(test_unsorted);
+  RUN_TEST(test_evaluateSpan);
+  RUN_TEST(test_resample);
+  RUN_TEST(test_resampleOutOfBounds);
+  UNITY_END(); // stop unit testing
+}
+
+void test_evaluate(void)
+{
+  setup_testMap();
+  // Includes inputs out of bounds at both ends
+  static int X_in[130];
+  static int Y_in[60];
+  for (unsigned int i = 0; i < 130; i++) { X_in[i] = -50 + static_cast<int>(i) * 48; }
+  for (unsigned int j = 0; j < 60; j++) { Y_in[j] = 8 + static_cast<int>(j) * 3 / 2; }
+  static double grid[130 * 60];
+  TableGrid::evaluate(testMap, X_in, 130, Y_in, 60, grid, 1);
+  assert_grid(X_in, 130, Y_in, 60, grid);
+  TEST_ASSERT_EQUAL_DOUBLE(-1, grid[0]);
+}
+
+void test_threads(void)
+{
+  setup_testMap();
+  static int X_in[101];
+  static int Y_in[37];
+  for (unsigned int i = 0; i < 101; i++) { X_in[i] = i * 60; }
+  for (unsigned int j = 0; j < 37; j++) { Y_in[j] = 10 + j * 2; }
+  static double single[101 * 37];
+  static double grid[101 * 37];
+  TableGrid::evaluate(testMap, X_in, 101, Y_in, 37, single, 1);
+  const unsigned int threads[] = {2, 3, 8, 200, 0};
+  for (unsigned int t : threads) {
+    for (auto& v : grid) v = 0;
+    TableGrid::evaluate(testMap, X_in, 101, Y_in, 37, grid, t);
+    TEST_ASSERT_EQUAL_MEMORY(single, grid, sizeof(grid));
+  }
+  assert_grid(X_in, 101, Y_in, 37, grid);
+}
+
+void test_unsorted(void)
+{
+  // Inputs in any order are found, sorted inputs only walk faster
+  setup_testMap();
+  const int X_in[] = {5000, 10, 2000, 2000, 600, 5999};
+  const int Y_in[] = {99, 10, 50, 21};
+  double grid[6 * 4];
+  TableGrid::evaluate(testMap, X_in, 6, Y_in, 4, grid, 2);
+  assert_grid(X_in, 6, Y_in, 4, grid);
+}
+
+void test_evaluateSpan(void)
+{
+  setup_testMap();
+  static double grid[64 * 16];
+  TableGrid::evaluate(testMap, 64, 16, grid, 4);
+  // The corners of the grid are the corners of the table
+  TEST_ASSERT_EQUAL_DOUBLE(testMap.getValueByIndex(0, 0), grid[0]);
+  TEST_ASSERT_EQUAL_DOUBLE(testMap.getValueByIndex(0, ySize - 1), grid[15]);
+  TEST_ASSERT_EQUAL_DOUBLE(testMap.getValueByIndex(xSize - 1, 0), grid[63 * 16]);
+  TEST_ASSERT_EQUAL_DOUBLE(testMap.getValueByIndex(xSize - 1, ySize - 1), grid[64 * 16 - 1]);
+  for (unsigned int i = 0; i < 64 * 16; i++) { TEST_ASSERT_TRUE(grid[i] >= 0); }
+
+  Table<uint8_t, 3> curve({0, 10, 20}, {0, 100, 50});
+  double line[5];
+  TableGrid::evaluate(curve, 5, 1, line);
+  const double expected[] = {0, 50, 100, 75, 50};
+  for (unsigned int i = 0; i < 5; i++) { TEST_ASSERT_EQUAL_DOUBLE(expected[i], line[i]); }
+}
+
+void test_resample(void)
+{
+  setup_testMap();
+  // Onto finer axes, with the value type narrowed and rounded
+  Table<uint8_t, 12, 9> fine;
+  fine.initialise();
+  int xAxis[12];
+  int yAxis[9];
+  for (unsigned int x = 0; x < 12; x++) { xAxis[x] = x * 6000 / 11; }
+  for (unsigned int y = 0; y < 9; y++) { yAxis[y] = 10 + y * 90 / 8; }
+  fine.setXAxis(xAxis, 12);
+  fine.setYAxis(yAxis, 9);
+  TEST_ASSERT_TRUE(TableGrid::resample(testMap, fine, 3));
+  for (unsigned int x = 0; x < 12; x++) {
+    for (unsigned int y = 0; y < 9; y++) {
+      const double expected = testMap.getValue(xAxis[x], yAxis[y]);
+      TEST_ASSERT_EQUAL(static_cast<uint8_t>(expected + 0.5), fine.getValueByIndex(x, y));
+    }
+  }
+
+  // Onto its own breakpoints the table is unchanged
+  Table<uint16_t, xSize, ySize> copy;
+  copy.initialise();
+  copy.setXAxis(tempXAxis, xSize);
+  copy.setYAxis(tempYAxis, ySize);
+  TEST_ASSERT_TRUE(TableGrid::resample(testMap, copy));
+  for (unsigned int x = 0; x < xSize; x++) {
+    for (unsigned int y = 0; y < ySize; y++) { TEST_ASSERT_EQUAL(testMap.getValueByIndex(x, y), copy.getValueByIndex(x, y)); }
+  }
+}
+
+void test_resampleOutOfBounds(void)
+{
+  setup_testMap();
+  Table<uint16_t, 3, 3> wide({0, 3000, 6500}, {10, 50, 100}, {1, 2, 3, 4, 5, 6, 7, 8, 9});
+  TEST_ASSERT_FALSE(TableGrid::resample(testMap, wide));
+  TEST_ASSERT_EQUAL(5, wide.getValueByIndex(1, 1));
+}
+
+void setUp (void) {}
+
+void tearDown (void) {}
+
+int main(int argc, char **argv) {
+  run_tests();
+  return 0;
+}
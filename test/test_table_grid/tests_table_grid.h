@@ -0,0 +1,16 @@
+#include <unity.h>
+#include <cstdio>
+
+void run_tests();
+void test_evaluate(void);
+void test_threads(void);
+void test_unsorted(void);
+void test_evaluateSpan(void);
+void test_resample(void);
+void test_resampleOutOfBounds(void);
+
+constexpr unsigned int xSize = 6;
+constexpr unsigned int ySize = 5;
+
+constexpr int tempXAxis[xSize] = {0, 500, 1200, 2000, 3500, 6000};
+constexpr int tempYAxis[ySize] = {10, 20, 45, 70, 100};
@@ -0,0 +1,158 @@
+#include "tests_table_image.h"
+
+#include "Table.h"
+
+#include <string.h>
+
+Table<uint16_t, xSize, ySize> testMap;
+
+void setup_testMap(void)
+{
+  //Values wider than a byte and negative axis values, which must survive a save and load
+  testMap.initialise();
+  for (unsigned int x = 0; x < xSize; x++) { testMap.setXAxisValueByIndex(x, tempXAxis[x]); }
+  for (unsigned int y = 0; y < ySize; y++) { testMap.setYAxisValueByIndex(y, tempYAxis[y]); }
+  for (unsigned int i = 0; i < xSize * ySize; i++) { testMap.setValueByIndex(i / ySize, i % ySize, tempValues[i]); }
+}
+
+void run_tests()
+{
+  UNITY_BEGIN(); // IMPORTANT LINE!
+  RUN_TEST(test_imageSize);
+  RUN_TEST(test_crc32);
+  RUN_TEST(test_roundTrip);
+  RUN_TEST(test_roundTripLayout);
+  RUN_TEST(test_rejectCorrupt);
+  RUN_TEST(test_rejectType);
+  RUN_TEST(test_loadSwapped);
+  UNITY_END(); // stop unit testing
+}
+
+void test_imageSize(void)
+{
+  // Header, values, x axis and y axis each padded to 8 bytes, then the crc
+  TEST_ASSERT_EQUAL(16 + 16 + 16 + 8 + 4, testMap.getSize());
+}
+
+void test_crc32(void)
+{
+  // The check value of CRC-32, from both the byte and the nibble table, whole and in parts
+  const unsigned char check[] = "123456789";
+  TEST_ASSERT_EQUAL_HEX32(0xCBF43926, TableImageFormat::crc32(check, 9));
+  TEST_ASSERT_EQUAL_HEX32(0xCBF43926, TableImageFormat::crc32(check + 4, 5, TableImageFormat::crc32(check, 4)));
+  TEST_ASSERT_EQUAL_HEX32(0xCBF43926, ~TableCrc32<true>::update(~0u, check, 9));
+  TEST_ASSERT_EQUAL_HEX32(0xCBF43926, ~TableCrc32<false>::update(~0u, check, 9));
+}
+
+void test_roundTrip(void)
+{
+  setup_testMap();
+
+  char image[testMap.getSize()];
+  TEST_ASSERT_TRUE(testMap.saveData(image, sizeof(image)));
+
+  Table<uint16_t, xSize, ySize> copy;
+  copy.initialise();
+  TEST_ASSERT_TRUE(copy.loadData(image, sizeof(image)));
+
+  for (unsigned int i = 0; i < xSize * ySize; i++) {
+    TEST_ASSERT_EQUAL(tempValues[i], copy.getValueByIndex(i / ySize, i % ySize));
+  }
+  TEST_ASSERT_EQUAL(testMap.getValue(-500, 100), copy.getValue(-500, 100));
+  TEST_ASSERT_EQUAL(40000, copy.getValue(0, 20));
+  TEST_ASSERT_EQUAL(-1, copy.getValue(-1001, 20));
+}
+
+void test_roundTripLayout(void)
+{
+  setup_testMap();
+
+  // The image is the same whatever the memory layout
+  Table<uint16_t, xSize, ySize, int, int, double, TableTiled<2>> tiled;
+  char image[testMap.getSize()];
+  char tiledImage[tiled.getSize()];
+  TEST_ASSERT_TRUE(testMap.saveData(image, sizeof(image)));
+  TEST_ASSERT_TRUE(tiled.loadData(image, sizeof(image)));
+  TEST_ASSERT_TRUE(tiled.saveData(tiledImage, sizeof(tiledImage)));
+  TEST_ASSERT_EQUAL_MEMORY(image, tiledImage, sizeof(image));
+  TEST_ASSERT_EQUAL(65535, tiled.getValueByIndex(1, 1));
+}
+
+void test_rejectCorrupt(void)
+{
+  setup_testMap();
+
+  char image[testMap.getSize()];
+  TEST_ASSERT_TRUE(testMap.saveData(image, sizeof(image)));
+  TEST_ASSERT_FALSE(testMap.saveData(image, sizeof(image) - 1));
+
+  Table<uint16_t, xSize, ySize> copy;
+  copy.initialise();
+
+  // Wrong size
+  TEST_ASSERT_FALSE(copy.loadData(image, sizeof(image) - 1));
+
+  // A flipped bit fails the crc and leaves the table unchanged
+  image[20] ^= 0x10;
+  TEST_ASSERT_FALSE(copy.loadData(image, sizeof(image)));
+  TEST_ASSERT_EQUAL(0, copy.getValueByIndex(1, 1));
+  image[20] ^= 0x10;
+  TEST_ASSERT_TRUE(copy.loadData(image, sizeof(image)));
+}
+
+void test_rejectType(void)
+{
+  setup_testMap();
+
+  char image[testMap.getSize()];
+  TEST_ASSERT_TRUE(testMap.saveData(image, sizeof(image)));
+
+  // Same image size, different value type or dimensions
+  Table<int16_t, xSize, ySize> otherType;
+  Table<uint16_t, ySize, xSize> otherSize;
+  TEST_ASSERT_EQUAL(sizeof(image), otherType.getSize());
+  TEST_ASSERT_FALSE(otherType.loadData(image, sizeof(image)));
+  TEST_ASSERT_FALSE(otherSize.loadData(image, otherSize.getSize()));
+}
+
+void test_loadSwapped(void)
+{
+  setup_testMap();
+
+  typedef TableImage<uint16_t, xSize, ySize, int, int> Image;
+  unsigned char image[Image::size()];
+  TEST_ASSERT_TRUE(testMap.saveData(reinterpret_cast<char*>(image), sizeof(image)));
+
+  // Convert to the other byte order, as if written by a target of the other endianness
+  TableImageHeader header;
+  memcpy(&header, image, sizeof(header));
+  TableImageFormat::swapBytes(&header.magic, sizeof(header.magic), 1);
+  TableImageFormat::swapBytes(&header.version, sizeof(header.version), 1);
+  TableImageFormat::swapBytes(&header.xSize, sizeof(header.xSize), 1);
+  TableImageFormat::swapBytes(&header.ySize, sizeof(header.ySize), 1);
+  header.byteOrder ^= 1;
+  memcpy(image, &header, sizeof(header));
+  TableImageFormat::swapBytes(image + Image::valuesOffset(), sizeof(uint16_t), xSize * ySize);
+  TableImageFormat::swapBytes(image + Image::xAxisOffset(), sizeof(int), xSize);
+  TableImageFormat::swapBytes(image + Image::yAxisOffset(), sizeof(int), ySize);
+  uint32_t crc = TableImageFormat::crc32(image, Image::crcOffset());
+  TableImageFormat::swapBytes(&crc, sizeof(crc), 1);
+  memcpy(image + Image::crcOffset(), &crc, sizeof(crc));
+
+  Table<uint16_t, xSize, ySize> copy;
+  copy.initialise();
+  TEST_ASSERT_TRUE(copy.loadData(reinterpret_cast<char*>(image), sizeof(image)));
+  for (unsigned int i = 0; i < xSize * ySize; i++) {
+    TEST_ASSERT_EQUAL(tempValues[i], copy.getValueByIndex(i / ySize, i % ySize));
+  }
+  TEST_ASSERT_EQUAL(testMap.getValue(-500, 100), copy.getValue(-500, 100));
+}
+
+void setUp (void) {}
+
+void tearDown (void) {}
+
+int main(int argc, char **argv) {
+  run_tests();
+  return 0;
+}
@@ -0,0 +1,19 @@
+#include <unity.h>
+#include <cstdio>
+
+void run_tests();
+void setup_testMap(void);
+void test_imageSize(void);
+void test_crc32(void);
+void test_roundTrip(void);
+void test_roundTripLayout(void);
+void test_rejectCorrupt(void);
+void test_rejectType(void);
+void test_loadSwapped(void);
+
+constexpr unsigned int xSize = 3;
+constexpr unsigned int ySize = 2;
+
+constexpr int tempXAxis[xSize] = {-1000, 0, 2500};
+constexpr int tempYAxis[ySize] = {20, 300};
+constexpr uint16_t tempValues[xSize * ySize] = {1, 300, 40000, 65535, 256, 12345};
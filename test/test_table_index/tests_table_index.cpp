@@ -0,0 +1,179 @@
+#include "tests_table_index.h"
+
+#include "Table.h"
+
+typedef Table<uint16_t, xSize, ySize, uint8_t, uint8_t> SearchTable;
+template<unsigned int bits>
+using LutTable = Table<uint16_t, xSize, ySize, uint8_t, uint8_t, double, TableRowMajor, 1, TableNoStats, TableIndexLut<bits>>;
+
+// The look up table is the only memory added, one byte per entry for small axes
+static_assert(sizeof(LutTable<8>) >= sizeof(SearchTable) + 2 * 256, "A dense uint8_t index holds 256 entries per axis");
+static_assert(sizeof(LutTable<4>) < sizeof(SearchTable) + 2 * 64, "A 4 bit index holds 16 entries per axis");
+
+constexpr uint8_t xAxis[xSize] = {0, 3, 4, 20, 21, 90, 200, 255};
+constexpr uint8_t yAxis[ySize] = {10, 11, 40, 41, 42, 250};
+
+template<typename Map>
+void setup_testMap(Map& map)
+{
+  map.initialise();
+  for (unsigned int x = 0; x < xSize; x++) { map.setXAxisValueByIndex(x, xAxis[x]); }
+  for (unsigned int y = 0; y < ySize; y++) { map.setYAxisValueByIndex(y, yAxis[y]); }
+  for (unsigned int x = 0; x < xSize; x++) {
+    for (unsigned int y = 0; y < ySize; y++) { map.setValueByIndex(x, y, (x * 37 + y * 101) % 500); }
+  }
+}
+
+/**
+ * Compares every input of the axes, and one past each end, with the search.
+ */
+template<typename Map>
+void assert_matchesSearch(Map& map, SearchTable& reference)
+{
+  const Map& constMap = map;
+  for (unsigned int x = 0; x < 256; x++) {
+    for (unsigned int y = 0; y < 256; y += 3) {
+      const double expected = reference.getValue(x, y);
+      TEST_ASSERT_EQUAL_DOUBLE(expected, map.getValue(x, y));
+      TEST_ASSERT_EQUAL_DOUBLE(expected, constMap.getValue(x, y));
+    }
+  }
+}
+
+void run_tests()
+{
+  UNITY_BEGIN(); // IMPORTANT LINE!
+  RUN_TEST(test_denseIndex);
+  RUN_TEST(test_quantisedIndex);
+  RUN_TEST(test_wideAxis);
+  RUN_TEST(test_singleAxis);
+  RUN_TEST(test_axisUpdate);
+  RUN_TEST(test_deferredBuild);
+  RUN_TEST(test_loadData);
+  RUN_TEST(test_romTable);
+  UNITY_END(); // stop unit testing
+}
+
+void test_denseIndex(void)
+{
+  SearchTable reference;
+  setup_testMap(reference);
+  LutTable<8> map;
+  setup_testMap(map);
+  assert_matchesSearch(map, reference);
+  TEST_ASSERT_EQUAL_DOUBLE(reference.getValue(21, 41), map.getValue(21, 41));
+  TEST_ASSERT_EQUAL(-1, map.getValue(5, 5));
+}
+
+void test_quantisedIndex(void)
+{
+  // Coarse buckets hold several breakpoints
+  SearchTable reference;
+  setup_testMap(reference);
+  LutTable<1> map1;
+  setup_testMap(map1);
+  assert_matchesSearch(map1, reference);
+  LutTable<3> map3;
+  setup_testMap(map3);
+  assert_matchesSearch(map3, reference);
+  LutTable<6> map6;
+  setup_testMap(map6);
+  assert_matchesSearch(map6, reference);
+}
+
+void test_wideAxis(void)
+{
+  // 12 bit ADC axis, quantised to 64 entries
+  constexpr unsigned int size = 9;
+  constexpr uint16_t adc[size] = {0, 50, 51, 400, 1000, 1024, 2047, 3000, 4095};
+  Table<float, size, 1, uint16_t> reference;
+  Table<float, size, 1, uint16_t, int, double, TableRowMajor, 1, TableNoStats, TableIndexLut<6>> map;
+  reference.initialise();
+  map.initialise();
+  for (unsigned int x = 0; x < size; x++) {
+    reference.setXAxisValueByIndex(x, adc[x]);
+    reference.setValueByIndex(x, x * x * 1.5f);
+    map.setXAxisValueByIndex(x, adc[x]);
+    map.setValueByIndex(x, x * x * 1.5f);
+  }
+  for (unsigned int x = 0; x <= 4096; x++) {
+    TEST_ASSERT_EQUAL_DOUBLE(reference.getValue(x), map.getValue(x));
+  }
+}
+
+void test_singleAxis(void)
+{
+  // A (x, 1) table has no y segments to look up
+  Table<uint8_t, 4, 1, uint8_t, int, double, TableRowMajor, 1, TableNoStats, TableIndexLut<8>> map({10, 20, 60, 100}, {0, 10, 50, 90});
+  TEST_ASSERT_EQUAL_DOUBLE(5, map.getValue(15));
+  TEST_ASSERT_EQUAL_DOUBLE(50, map.getValue(60));
+  TEST_ASSERT_EQUAL_DOUBLE(70, map.getValue(80));
+  TEST_ASSERT_EQUAL(-1, map.getValue(101));
+}
+
+void test_axisUpdate(void)
+{
+  // Setting a breakpoint rebuilds the index of its axis before the next lookup
+  SearchTable reference;
+  setup_testMap(reference);
+  LutTable<5> map;
+  setup_testMap(map);
+  TEST_ASSERT_EQUAL_DOUBLE(reference.getValue(100, 30), map.getValue(100, 30));
+  reference.setXAxisValueByIndex(5, 150);
+  map.setXAxisValueByIndex(5, 150);
+  reference.setYAxisValueByIndex(2, 12);
+  map.setYAxisValueByIndex(2, 12);
+  assert_matchesSearch(map, reference);
+
+  map.resetData();
+  TEST_ASSERT_EQUAL(0, map.getValue(0, 0));
+}
+
+void test_deferredBuild(void)
+{
+  // Breakpoints set one at a time leave the index out of date, const lookups search until it is built
+  SearchTable reference;
+  setup_testMap(reference);
+  LutTable<5> map;
+  setup_testMap(map);
+  const LutTable<5>& constMap = map;
+  reference.setXAxisValueByIndex(5, 150);
+  map.setXAxisValueByIndex(5, 150);
+  for (unsigned int x = 0; x < 256; x++) {
+    TEST_ASSERT_EQUAL_DOUBLE(reference.getValue(x, 30), constMap.getValue(x, 30));
+  }
+  map.buildAxisIndexes();
+  for (unsigned int x = 0; x < 256; x++) {
+    TEST_ASSERT_EQUAL_DOUBLE(reference.getValue(x, 30), constMap.getValue(x, 30));
+  }
+  assert_matchesSearch(map, reference);
+}
+
+void test_loadData(void)
+{
+  SearchTable reference;
+  setup_testMap(reference);
+  char buffer[SearchTable::getSize()];
+  TEST_ASSERT_TRUE(reference.saveData(buffer, sizeof(buffer)));
+  LutTable<7> map;
+  map.initialise();
+  TEST_ASSERT_TRUE(map.loadData(buffer, sizeof(buffer)));
+  assert_matchesSearch(map, reference);
+}
+
+void test_romTable(void)
+{
+  // The index is built by the constexpr constructor
+  static constexpr Table<uint8_t, 3, 2, uint8_t, uint8_t, double, TableRowMajor, 1, TableNoStats, TableIndexLut<8>> romMap({0, 100, 200}, {0, 50}, {0, 10, 100, 110, 200, 210});
+  TEST_ASSERT_EQUAL_DOUBLE(155, romMap.getValue(150, 25));
+  TEST_ASSERT_EQUAL_DOUBLE(210, romMap.getValue(200, 50));
+}
+
+void setUp (void) {}
+
+void tearDown (void) {}
+
+int main(int argc, char **argv) {
+  run_tests();
+  return 0;
+}
@@ -0,0 +1,15 @@
+#include <unity.h>
+#include <cstdio>
+
+void run_tests();
+void test_denseIndex(void);
+void test_quantisedIndex(void);
+void test_wideAxis(void);
+void test_singleAxis(void);
+void test_axisUpdate(void);
+void test_deferredBuild(void);
+void test_loadData(void);
+void test_romTable(void);
+
+constexpr unsigned int xSize = 8;
+constexpr unsigned int ySize = 6;
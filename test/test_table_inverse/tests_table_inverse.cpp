@@ -0,0 +1,160 @@
+#include "tests_table_inverse.h"
+
+#include "Table.h"
+
+Table<uint16_t, xSize, ySize> testMap;
+
+void setup_testMap(void)
+{
+  /*
+  Rising along x at every y, rising along y at every x
+  100 |   40 |  100 |  160 |  300 |  380 |  500
+   70 |   30 |   80 |  140 |  250 |  330 |  450
+   40 |   20 |   60 |  100 |  200 |  260 |  350
+   20 |   10 |   40 |   60 |  100 |  180 |  200
+      -------------------------------------------
+           0 |  500 | 1200 | 2000 | 3500 | 6000
+  */
+  constexpr uint16_t rows[ySize][xSize] = {{10, 40, 60, 100, 180, 200}, {20, 60, 100, 200, 260, 350}, {30, 80, 140, 250, 330, 450}, {40, 100, 160, 300, 380, 500}};
+  testMap.initialise();
+  TEST_ASSERT_TRUE(testMap.setXAxis(tempXAxis, xSize));
+  TEST_ASSERT_TRUE(testMap.setYAxis(tempYAxis, ySize));
+  for (unsigned int x = 0; x < xSize; x++) {
+    for (unsigned int y = 0; y < ySize; y++) { testMap.setValueByIndex(x, y, rows[y][x]); }
+  }
+}
+
+void run_tests()
+{
+  UNITY_BEGIN(); // IMPORTANT LINE!
+  RUN_TEST(test_roundTrip);
+  RUN_TEST(test_breakpoints);
+  RUN_TEST(test_falling);
+  RUN_TEST(test_flat);
+  RUN_TEST(test_notMonotonic);
+  RUN_TEST(test_outOfRange);
+  RUN_TEST(test_yAxis);
+  RUN_TEST(test_table2d);
+  UNITY_END(); // stop unit testing
+}
+
+void test_roundTrip(void)
+{
+  setup_testMap();
+  double x = 0;
+  for (int y = 20; y <= 100; y += 7) {
+    for (double target = 45; target <= 195; target += 2.5) {
+      TEST_ASSERT_TRUE(testMap.getXForValue(target, y, x));
+      // The table is linear along x within a segment, so the solution is exact
+      const double X_in = static_cast<int>(x);
+      const double X_next = X_in + 1;
+      TEST_ASSERT_TRUE(testMap.getValue(X_in, y) <= target + 1e-9);
+      TEST_ASSERT_TRUE(testMap.getValue(X_next, y) >= target - 1e-9);
+    }
+  }
+  TEST_ASSERT_TRUE(testMap.getXForValue(80, 40, x));
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, 850, x);
+  TEST_ASSERT_TRUE(testMap.getXForValue(150, 40, x));
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, 1600, x);
+}
+
+void test_breakpoints(void)
+{
+  setup_testMap();
+  double x = 0;
+  TEST_ASSERT_TRUE(testMap.getXForValue(10, 20, x));
+  TEST_ASSERT_EQUAL_DOUBLE(0, x);
+  TEST_ASSERT_TRUE(testMap.getXForValue(200, 20, x));
+  TEST_ASSERT_EQUAL_DOUBLE(6000, x);
+  TEST_ASSERT_TRUE(testMap.getXForValue(100, 40, x));
+  TEST_ASSERT_EQUAL_DOUBLE(1200, x);
+  TEST_ASSERT_TRUE(testMap.getXForValue(300, 100, x));
+  TEST_ASSERT_EQUAL_DOUBLE(2000, x);
+}
+
+void test_falling(void)
+{
+  // Pulse width falling with voltage
+  Table<float, 4, 1, int> deadTime({8, 10, 12, 14}, {1.5f, 1.0f, 0.75f, 0.625f});
+  double x = 0;
+  TEST_ASSERT_TRUE(deadTime.getXForValue(1.25, x));
+  TEST_ASSERT_DOUBLE_WITHIN(1e-6, 9, x);
+  TEST_ASSERT_TRUE(deadTime.getXForValue(0.625, x));
+  TEST_ASSERT_DOUBLE_WITHIN(1e-6, 14, x);
+  TEST_ASSERT_FALSE(deadTime.getXForValue(1.6, x));
+}
+
+void test_flat(void)
+{
+  // The lowest x of a flat part is returned
+  Table<uint8_t, 5, 1> curve({0, 10, 20, 30, 40}, {0, 50, 50, 50, 100});
+  double x = 0;
+  TEST_ASSERT_TRUE(curve.getXForValue(50, x));
+  TEST_ASSERT_EQUAL_DOUBLE(10, x);
+  TEST_ASSERT_TRUE(curve.getXForValue(75, x));
+  TEST_ASSERT_EQUAL_DOUBLE(35, x);
+  Table<uint8_t, 3, 1> constant({0, 10, 20}, {7, 7, 7});
+  TEST_ASSERT_TRUE(constant.getXForValue(7, x));
+  TEST_ASSERT_EQUAL_DOUBLE(0, x);
+  TEST_ASSERT_FALSE(constant.getXForValue(8, x));
+}
+
+void test_notMonotonic(void)
+{
+  setup_testMap();
+  double x = 0;
+  testMap.setValueByIndex(3, 1, 50);
+  // The drop from 100 to 50 is found away from the target as well as on its search
+  TEST_ASSERT_FALSE(testMap.getXForValue(30, 40, x));
+  TEST_ASSERT_FALSE(testMap.getXForValue(200, 40, x));
+  TEST_ASSERT_FALSE(testMap.getXForValue(30, 30, x));
+  TEST_ASSERT_FALSE(testMap.getXForValue(30, 50, x));
+  // Only the rows either side of Y_in are checked
+  TEST_ASSERT_TRUE(testMap.getXForValue(30, 20, x));
+  TEST_ASSERT_TRUE(testMap.getXForValue(140, 70, x));
+  TEST_ASSERT_EQUAL_DOUBLE(1200, x);
+}
+
+void test_outOfRange(void)
+{
+  setup_testMap();
+  double x = 0;
+  TEST_ASSERT_FALSE(testMap.getXForValue(9, 20, x));
+  TEST_ASSERT_FALSE(testMap.getXForValue(201, 20, x));
+  TEST_ASSERT_FALSE(testMap.getXForValue(100, 19, x));
+  TEST_ASSERT_FALSE(testMap.getXForValue(100, 101, x));
+  TEST_ASSERT_FALSE(testMap.getYForValue(100, 6001, x));
+}
+
+void test_yAxis(void)
+{
+  setup_testMap();
+  double y = 0;
+  TEST_ASSERT_TRUE(testMap.getYForValue(60, 1200, y));
+  TEST_ASSERT_EQUAL_DOUBLE(20, y);
+  TEST_ASSERT_TRUE(testMap.getYForValue(120, 1200, y));
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, 55, y);
+  for (int x = 0; x <= 6000; x += 250) {
+    const double target = testMap.getValue(x, 63);
+    TEST_ASSERT_TRUE(testMap.getYForValue(target, x, y));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 63, y);
+  }
+}
+
+void test_table2d(void)
+{
+  Table<uint8_t, 4> curve({0, 100, 200, 300}, {0, 20, 80, 90});
+  double x = 0;
+  TEST_ASSERT_TRUE(curve.getXForValue(50, x));
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, 150, x);
+  TEST_ASSERT_EQUAL_DOUBLE(50, curve.getValue(150));
+}
+
+void setUp (void) {}
+
+void tearDown (void) {}
+
+int main(int argc, char **argv) {
+  run_tests();
+  return 0;
+}
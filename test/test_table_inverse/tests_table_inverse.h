@@ -0,0 +1,18 @@
+#include <unity.h>
+#include <cstdio>
+
+void run_tests();
+void test_roundTrip(void);
+void test_breakpoints(void);
+void test_falling(void);
+void test_flat(void);
+void test_notMonotonic(void);
+void test_outOfRange(void);
+void test_yAxis(void);
+void test_table2d(void);
+
+constexpr unsigned int xSize = 6;
+constexpr unsigned int ySize = 4;
+
+constexpr int tempXAxis[xSize] = {0, 500, 1200, 2000, 3500, 6000};
+constexpr int tempYAxis[ySize] = {20, 40, 70, 100};
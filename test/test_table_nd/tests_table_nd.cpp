@@ -0,0 +1,196 @@
+#include "tests_table_nd.h"
+
+#include "TableND.h"
+
+typedef TableND<uint8_t, TableAxis<xSize>, TableAxis<ySize>, TableAxis<zSize, signed char>> TestTable;
+
+TestTable testMap;
+
+/**
+ * Cell (x, y, z) holds a different value for every cell, not a linear function of its indices.
+ */
+unsigned int cell_value(unsigned int x, unsigned int y, unsigned int z)
+{
+  return (x * 37 + y * 11 + z * 71 + x * y * 5 + y * z * 3) % 200;
+}
+
+void setup_testMap(void)
+{
+  testMap.initialise();
+  for (unsigned int x = 0; x < xSize; x++) { testMap.setAxisValueByIndex<0>(x, tempXAxis[x]); }
+  for (unsigned int y = 0; y < ySize; y++) { testMap.setAxisValueByIndex<1>(y, tempYAxis[y]); }
+  for (unsigned int z = 0; z < zSize; z++) { testMap.setAxisValueByIndex<2>(z, tempZAxis[z]); }
+  for (unsigned int x = 0; x < xSize; x++) {
+    for (unsigned int y = 0; y < ySize; y++) {
+      for (unsigned int z = 0; z < zSize; z++) { testMap.setValueByIndex({x, y, z}, cell_value(x, y, z)); }
+    }
+  }
+}
+
+void run_tests()
+{
+  UNITY_BEGIN(); // IMPORTANT LINE!
+  RUN_TEST(test_trilinear);
+  RUN_TEST(test_breakpoints);
+  RUN_TEST(test_outOfBounds);
+  RUN_TEST(test_matchesTable);
+  RUN_TEST(test_matchesManualBlend);
+  RUN_TEST(test_singleBreakpointAxis);
+  RUN_TEST(test_setValueByIndex);
+  RUN_TEST(test_floatAxis);
+  UNITY_END(); // stop unit testing
+}
+
+void test_trilinear(void)
+{
+  // A linear function of the axes is interpolated exactly
+  TestTable map;
+  map.initialise();
+  for (unsigned int x = 0; x < xSize; x++) { map.setAxisValueByIndex<0>(x, tempXAxis[x]); }
+  for (unsigned int y = 0; y < ySize; y++) { map.setAxisValueByIndex<1>(y, tempYAxis[y]); }
+  for (unsigned int z = 0; z < zSize; z++) { map.setAxisValueByIndex<2>(z, tempZAxis[z]); }
+  for (unsigned int x = 0; x < xSize; x++) {
+    for (unsigned int y = 0; y < ySize; y++) {
+      for (unsigned int z = 0; z < zSize; z++) { map.setValueByIndex({x, y, z}, x * 2 + y * 3 + z * 5); }
+    }
+  }
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 2 * 0.5 + 3 * 1.5 + 5 * 0.5, map.getValue(15, 25, 10));
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 2 * 2.9 + 3 * 0.1 + 5 * 1.8, map.getValue(39, 11, 80));
+  TEST_ASSERT_EQUAL(3, TestTable::dims);
+  TEST_ASSERT_EQUAL(xSize * ySize * zSize, TestTable::cells);
+}
+
+void test_breakpoints(void)
+{
+  setup_testMap();
+  for (unsigned int x = 0; x < xSize; x++) {
+    for (unsigned int y = 0; y < ySize; y++) {
+      for (unsigned int z = 0; z < zSize; z++) {
+        TEST_ASSERT_EQUAL(cell_value(x, y, z), testMap.getValue(tempXAxis[x], tempYAxis[y], tempZAxis[z]));
+      }
+    }
+  }
+}
+
+void test_outOfBounds(void)
+{
+  setup_testMap();
+  TEST_ASSERT_EQUAL(-1, testMap.getValue(9, 20, 0));
+  TEST_ASSERT_EQUAL(-1, testMap.getValue(41, 20, 0));
+  TEST_ASSERT_EQUAL(-1, testMap.getValue(20, 50, 0));
+  TEST_ASSERT_EQUAL(-1, testMap.getValue(20, 20, -21));
+  TEST_ASSERT_EQUAL(-1, testMap.getValue(20, 20, 91));
+  const TestTable& constMap = testMap;
+  TEST_ASSERT_EQUAL(-1, constMap.getValue(20, 20, 91));
+}
+
+void test_matchesTable(void)
+{
+  // With two axes the result matches Table
+  TableND<uint8_t, TableAxis<xSize>, TableAxis<ySize>> map;
+  Table<uint8_t, xSize, ySize> table;
+  map.initialise();
+  table.initialise();
+  for (unsigned int x = 0; x < xSize; x++) {
+    map.setAxisValueByIndex<0>(x, tempXAxis[x] * x);
+    table.setXAxisValueByIndex(x, tempXAxis[x] * x);
+  }
+  for (unsigned int y = 0; y < ySize; y++) {
+    map.setAxisValueByIndex<1>(y, tempYAxis[y]);
+    table.setYAxisValueByIndex(y, tempYAxis[y]);
+  }
+  for (unsigned int x = 0; x < xSize; x++) {
+    for (unsigned int y = 0; y < ySize; y++) {
+      map.setValueByIndex({x, y}, cell_value(x, y, 1));
+      table.setValueByIndex(x, y, cell_value(x, y, 1));
+    }
+  }
+  for (int x = 0; x <= 120; x += 7) {
+    for (int y = 10; y <= 40; y += 3) {
+      TEST_ASSERT_FLOAT_WITHIN(0.0001, table.getValue(x, y), map.getValue(x, y));
+    }
+  }
+}
+
+void test_matchesManualBlend(void)
+{
+  // The same result as a 2d lookup in each z plane, blended by hand
+  setup_testMap();
+  Table<uint8_t, xSize, ySize> planes[zSize];
+  for (unsigned int z = 0; z < zSize; z++) {
+    planes[z].initialise();
+    for (unsigned int x = 0; x < xSize; x++) { planes[z].setXAxisValueByIndex(x, tempXAxis[x]); }
+    for (unsigned int y = 0; y < ySize; y++) { planes[z].setYAxisValueByIndex(y, tempYAxis[y]); }
+    for (unsigned int x = 0; x < xSize; x++) {
+      for (unsigned int y = 0; y < ySize; y++) { planes[z].setValueByIndex(x, y, cell_value(x, y, z)); }
+    }
+  }
+  const TestTable& constMap = testMap;
+  for (int x = 10; x <= 40; x += 3) {
+    for (int y = 10; y <= 40; y += 7) {
+      for (int z = -20; z <= 90; z += 11) {
+        const unsigned int zIdx = z < tempZAxis[1] ? 0 : 1;
+        const double w = static_cast<double>(z - tempZAxis[zIdx]) / (tempZAxis[zIdx + 1] - tempZAxis[zIdx]);
+        const double lower = planes[zIdx].getValue(x, y);
+        const double upper = planes[zIdx + 1].getValue(x, y);
+        TEST_ASSERT_FLOAT_WITHIN(0.0001, lower + (upper - lower) * w, testMap.getValue(x, y, z));
+        TEST_ASSERT_FLOAT_WITHIN(0.0001, lower + (upper - lower) * w, constMap.getValue(x, y, z));
+      }
+    }
+  }
+}
+
+void test_singleBreakpointAxis(void)
+{
+  TableND<int, TableAxis<3>, TableAxis<1>> map;
+  map.initialise();
+  for (unsigned int x = 0; x < 3; x++) {
+    map.setAxisValueByIndex<0>(x, x * 100);
+    map.setValueByIndex({x, 0}, x * x * 10);
+  }
+  map.setAxisValueByIndex<1>(0, 1);
+  TEST_ASSERT_EQUAL(5, map.getValue(50, 1));
+  TEST_ASSERT_EQUAL(25, map.getValue(150, 1));
+  TEST_ASSERT_EQUAL(-1, map.getValue(150, 2));
+}
+
+void test_setValueByIndex(void)
+{
+  setup_testMap();
+  TEST_ASSERT_TRUE(testMap.setValueByIndex({1, 2, 0}, 150));
+  TEST_ASSERT_EQUAL(150, testMap.getValueByIndex({1, 2, 0}));
+  TEST_ASSERT_EQUAL(150, testMap.getValue(20, 30, -20));
+  TEST_ASSERT_FALSE(testMap.setValueByIndex({4, 0, 0}, 1));
+  TEST_ASSERT_FALSE(testMap.setValueByIndex({0, 0, 3}, 1));
+  TEST_ASSERT_FALSE(testMap.setAxisValueByIndex<2>(3, 1));
+  TEST_ASSERT_EQUAL(90, testMap.getAxisValueByIndex<2>(2));
+}
+
+void test_floatAxis(void)
+{
+  //An evenly spaced floating point axis with a step below 1, searched rather than indexed
+  TableND<float, TableAxis<4, float>> map;
+  map.initialise();
+  constexpr float axis[4] = {0, 0.5f, 1, 1.5f};
+  constexpr float values[4] = {0, 10, 0, 10};
+  for (unsigned int x = 0; x < 4; x++) {
+    map.setAxisValueByIndex<0>(x, axis[x]);
+    map.setValueByIndex({x}, values[x]);
+  }
+  const TableND<float, TableAxis<4, float>>& constMap = map;
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 4, map.getValue(1.2f));
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 4, constMap.getValue(1.2f));
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 5, map.getValue(0.25f));
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 5, constMap.getValue(0.25f));
+  TEST_ASSERT_EQUAL(10, map.getValue(1.5f));
+  TEST_ASSERT_EQUAL(-1, map.getValue(1.75f));
+}
+
+void setUp (void) {}
+
+void tearDown (void) {}
+
+int main(int argc, char **argv) {
+  run_tests();
+  return 0;
+}
@@ -0,0 +1,20 @@
+#include <unity.h>
+#include <cstdio>
+
+void run_tests();
+void test_trilinear(void);
+void test_breakpoints(void);
+void test_outOfBounds(void);
+void test_matchesTable(void);
+void test_matchesManualBlend(void);
+void test_singleBreakpointAxis(void);
+void test_setValueByIndex(void);
+void test_floatAxis(void);
+
+constexpr unsigned int xSize = 4;
+constexpr unsigned int ySize = 4;
+constexpr unsigned int zSize = 3;
+
+constexpr int tempXAxis[xSize] = {10, 20, 30, 40};
+constexpr int tempYAxis[ySize] = {10, 20, 30, 40};
+constexpr int tempZAxis[zSize] = {-20, 40, 90};
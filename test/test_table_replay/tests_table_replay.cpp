@@ -0,0 +1,250 @@
+#include "tests_table_replay.h"
+
+#include "TableReplay.h"
+
+const char* binaryPath = "test_table_replay.bin";
+const char* csvPath = "test_table_replay.csv";
+
+// Log columns: rpm, map, logged fuel
+float sampleValue(unsigned int i, unsigned int c)
+{
+  switch (c) {
+    case 0: return static_cast<float>((i * 37) % 7000);
+    case 1: return 20 + static_cast<float>((i * 13) % 80);
+    default: return static_cast<float>(i % 50) * 0.5f;
+  }
+}
+
+void write_binaryLog(void)
+{
+  std::FILE* file = std::fopen(binaryPath, "wb");
+  for (unsigned int i = 0; i < samples; i++) {
+    for (unsigned int c = 0; c < columns; c++) {
+      const float value = sampleValue(i, c);
+      std::fwrite(&value, sizeof(value), 1, file);
+    }
+  }
+  std::fclose(file);
+}
+
+void write_csvLog(void)
+{
+  std::FILE* file = std::fopen(csvPath, "wb");
+  std::fprintf(file, "rpm,map,fuel,comment\n");
+  for (unsigned int i = 0; i < samples; i++) {
+    std::fprintf(file, "%g, %g,%g,x\r\n", sampleValue(i, 0), sampleValue(i, 1), sampleValue(i, 2));
+    if (i == 500) std::fprintf(file, "# lap 2\n");
+  }
+  // No line feed on the last line
+  std::fprintf(file, "1,2,3");
+  std::fclose(file);
+}
+
+void run_tests()
+{
+  UNITY_BEGIN(); // IMPORTANT LINE!
+  RUN_TEST(test_binaryLog);
+  RUN_TEST(test_binaryLogInvalid);
+  RUN_TEST(test_csvLog);
+  RUN_TEST(test_csvChunks);
+  RUN_TEST(test_channel);
+  RUN_TEST(test_channel2d);
+  RUN_TEST(test_channelNegative);
+  RUN_TEST(test_channelCapacity);
+  UNITY_END(); // stop unit testing
+  std::remove(binaryPath);
+  std::remove(csvPath);
+}
+
+void test_binaryLog(void)
+{
+  write_binaryLog();
+  TableBinaryLog<columns> log;
+  TEST_ASSERT_TRUE(log.open(binaryPath));
+  TEST_ASSERT_EQUAL(samples, log.samples());
+
+  // Batches which do not divide the log
+  static TableLogBatch<columns, 300> batch;
+  unsigned int total = 0;
+  while (log.read(batch) > 0) {
+    for (unsigned int i = 0; i < batch.count; i++) {
+      for (unsigned int c = 0; c < columns; c++) { TEST_ASSERT_EQUAL_FLOAT(sampleValue(total + i, c), batch.values[c][i]); }
+    }
+    total += batch.count;
+  }
+  TEST_ASSERT_EQUAL(samples, total);
+  TEST_ASSERT_EQUAL(0, batch.count);
+  log.rewind();
+  TEST_ASSERT_EQUAL(300, log.read(batch));
+  TEST_ASSERT_EQUAL_FLOAT(sampleValue(0, 1), batch.values[1][0]);
+}
+
+void test_binaryLogInvalid(void)
+{
+  TableBinaryLog<columns> log;
+  TEST_ASSERT_FALSE(log.open("test_table_replay.missing"));
+  // Not a whole number of samples
+  write_binaryLog();
+  TableBinaryLog<7> wide;
+  TEST_ASSERT_FALSE(wide.open(binaryPath));
+  static TableLogBatch<7, 16> batch;
+  TEST_ASSERT_EQUAL(0, wide.read(batch));
+}
+
+void test_csvLog(void)
+{
+  write_csvLog();
+  TableCsvLog<columns> log;
+  TEST_ASSERT_TRUE(log.open(csvPath));
+  static TableLogBatch<columns, 4096> batch;
+  TEST_ASSERT_EQUAL(samples + 1, log.read(batch));
+  for (unsigned int i = 0; i < samples; i++) {
+    for (unsigned int c = 0; c < columns; c++) { TEST_ASSERT_EQUAL_FLOAT(sampleValue(i, c), batch.values[c][i]); }
+  }
+  TEST_ASSERT_EQUAL_FLOAT(3, batch.values[2][samples]);
+  TEST_ASSERT_EQUAL(2, log.getSkipped());
+  TEST_ASSERT_EQUAL(0, log.read(batch));
+}
+
+void test_csvChunks(void)
+{
+  // Chunks much smaller than the log split many lines
+  write_csvLog();
+  TableCsvLog<columns> log(64);
+  TEST_ASSERT_TRUE(log.open(csvPath));
+  static TableLogBatch<columns, 97> batch;
+  unsigned int total = 0;
+  while (log.read(batch) > 0) {
+    for (unsigned int i = 0; i < batch.count && total + i < samples; i++) {
+      for (unsigned int c = 0; c < columns; c++) { TEST_ASSERT_EQUAL_FLOAT(sampleValue(total + i, c), batch.values[c][i]); }
+    }
+    total += batch.count;
+  }
+  TEST_ASSERT_EQUAL(samples + 1, total);
+  TEST_ASSERT_EQUAL(2, log.getSkipped());
+}
+
+void test_channel(void)
+{
+  // A (x, 1) table compared with a column logged from the same table
+  Table<uint8_t, 3> curve({0, 10, 20}, {0, 20, 60});
+  static TableLogBatch<2, 8> batch;
+  const float x[] = {0, 5, 10, 15, 20, 25, 4.6f, 12};
+  const float logged[] = {0, 10, 20, 40, 60, 0, 11, 26};
+  batch.count = 8;
+  for (unsigned int i = 0; i < 8; i++) {
+    batch.values[0][i] = x[i];
+    batch.values[1][i] = logged[i];
+  }
+  TableReplayChannel<decltype(curve)> channel(curve, 0, TableReplayChannel<decltype(curve)>::none, 1, 8);
+  const double* out = channel.process(batch);
+  TEST_ASSERT_EQUAL_DOUBLE(10, out[1]);
+  TEST_ASSERT_EQUAL_DOUBLE(-1, out[5]);
+  // 4.6 is rounded to the integer axis input 5
+  TEST_ASSERT_EQUAL_DOUBLE(10, out[6]);
+
+  TableReplayStats stats = channel.getStats();
+  TEST_ASSERT_EQUAL(8, stats.samples);
+  TEST_ASSERT_EQUAL(1, stats.outOfBounds);
+  TEST_ASSERT_EQUAL(7, stats.compared);
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, 1.0 / 7, stats.meanError);
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, 3.0 / 7, stats.meanAbsError);
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, std::sqrt(5.0 / 7), stats.rmsError);
+  TEST_ASSERT_EQUAL_DOUBLE(2, stats.maxAbsError);
+
+  channel.resetStats();
+  TEST_ASSERT_EQUAL(0, channel.getStats().samples);
+  TEST_ASSERT_EQUAL_DOUBLE(0, channel.getStats().rmsError);
+}
+
+void test_channel2d(void)
+{
+  // Replaying a log through the table it was logged from has no error
+  Table<float, 8, 5> fuelMap;
+  fuelMap.initialise();
+  for (unsigned int x = 0; x < 8; x++) { fuelMap.setXAxisValueByIndex(x, x * 1000); }
+  for (unsigned int y = 0; y < 5; y++) { fuelMap.setYAxisValueByIndex(y, 20 + y * 20); }
+  for (unsigned int x = 0; x < 8; x++) {
+    for (unsigned int y = 0; y < 5; y++) { fuelMap.setValueByIndex(x, y, x * 2.5f + y); }
+  }
+  std::FILE* file = std::fopen(binaryPath, "wb");
+  for (unsigned int i = 0; i < samples; i++) {
+    const float sample[columns] = {sampleValue(i, 0), sampleValue(i, 1), static_cast<float>(fuelMap.getValue(sampleValue(i, 0), sampleValue(i, 1)))};
+    std::fwrite(sample, sizeof(sample), 1, file);
+  }
+  std::fclose(file);
+
+  TableBinaryLog<columns> log;
+  TEST_ASSERT_TRUE(log.open(binaryPath));
+  static TableLogBatch<columns, 256> batch;
+  TableReplayChannel<decltype(fuelMap)> channel(fuelMap, 0, 1, 2, 256);
+  while (log.read(batch) > 0) { channel.process(batch); }
+  TableReplayStats stats = channel.getStats();
+  TEST_ASSERT_EQUAL(samples, stats.samples);
+  TEST_ASSERT_EQUAL(samples, stats.compared);
+  TEST_ASSERT_EQUAL(0, stats.outOfBounds);
+  TEST_ASSERT_DOUBLE_WITHIN(1e-5, 0, stats.maxAbsError);
+}
+
+void test_channelNegative(void)
+{
+  // A table value of -1 within the axes is compared, not counted out of bounds
+  Table<int8_t, 3> trim({0, 10, 20}, {-1, -1, 3});
+  static TableLogBatch<2, 4> batch;
+  const float x[] = {0, 5, 20, 21};
+  const float logged[] = {-1, -1, 3, 0};
+  batch.count = 4;
+  for (unsigned int i = 0; i < 4; i++) {
+    batch.values[0][i] = x[i];
+    batch.values[1][i] = logged[i];
+  }
+  TableReplayChannel<decltype(trim)> channel(trim, 0, TableReplayChannel<decltype(trim)>::none, 1, 4);
+  const double* out = channel.process(batch);
+  TEST_ASSERT_EQUAL_DOUBLE(-1, out[0]);
+  TEST_ASSERT_EQUAL_DOUBLE(-1, out[1]);
+  TEST_ASSERT_EQUAL_DOUBLE(-1, out[3]);
+
+  TableReplayStats stats = channel.getStats();
+  TEST_ASSERT_EQUAL(4, stats.samples);
+  TEST_ASSERT_EQUAL(1, stats.outOfBounds);
+  TEST_ASSERT_EQUAL(3, stats.compared);
+  TEST_ASSERT_EQUAL_DOUBLE(0, stats.maxAbsError);
+}
+
+void test_channelCapacity(void)
+{
+  // A batch larger than the capacity is looked up in parts, none of it is dropped
+  Table<float, 8, 5> fuelMap;
+  fuelMap.initialise();
+  for (unsigned int x = 0; x < 8; x++) { fuelMap.setXAxisValueByIndex(x, x * 1000); }
+  for (unsigned int y = 0; y < 5; y++) { fuelMap.setYAxisValueByIndex(y, 20 + y * 20); }
+  for (unsigned int x = 0; x < 8; x++) {
+    for (unsigned int y = 0; y < 5; y++) { fuelMap.setValueByIndex(x, y, x * 2.5f + y); }
+  }
+  static TableLogBatch<columns, 100> batch;
+  batch.count = 100;
+  for (unsigned int i = 0; i < 100; i++) {
+    for (unsigned int c = 0; c < columns; c++) { batch.values[c][i] = sampleValue(i, c); }
+  }
+
+  TableReplayChannel<decltype(fuelMap)> whole(fuelMap, 0, 1, 2, 100);
+  TableReplayChannel<decltype(fuelMap)> parts(fuelMap, 0, 1, 2, 7);
+  const double* expected = whole.process(batch);
+  const double* out = parts.process(batch);
+  for (unsigned int i = 0; i < 100; i++) {
+    TEST_ASSERT_EQUAL_DOUBLE(expected[i], out[i]);
+  }
+  TEST_ASSERT_EQUAL(100, parts.getStats().samples);
+  TEST_ASSERT_EQUAL(whole.getStats().outOfBounds, parts.getStats().outOfBounds);
+  TEST_ASSERT_EQUAL(whole.getStats().compared, parts.getStats().compared);
+  TEST_ASSERT_EQUAL_DOUBLE(whole.getStats().rmsError, parts.getStats().rmsError);
+}
+
+void setUp (void) {}
+
+void tearDown (void) {}
+
+int main(int argc, char **argv) {
+  run_tests();
+  return 0;
+}
@@ -0,0 +1,15 @@
+#include <unity.h>
+#include <cstdio>
+
+void run_tests();
+void test_binaryLog(void);
+void test_binaryLogInvalid(void);
+void test_csvLog(void);
+void test_csvChunks(void);
+void test_channel(void);
+void test_channel2d(void);
+void test_channelNegative(void);
+void test_channelCapacity(void);
+
+constexpr unsigned int columns = 3;
+constexpr unsigned int samples = 1000;
@@ -0,0 +1,176 @@
+#include "tests_table_set.h"
+
+#include "TableSet.h"
+
+typedef TableSet<uint8_t, K, xSize, ySize> MapSet;
+
+// The axes are stored once for every plane
+static_assert(sizeof(MapSet) < K * sizeof(Table<uint8_t, xSize, ySize>), "A TableSet is smaller than its planes as Tables");
+
+constexpr int xAxis[xSize] = {500, 1000, 2000, 3500, 5000, 7000};
+constexpr int yAxis[ySize] = {20, 40, 60, 80, 100};
+
+uint8_t planeValue(unsigned int k, unsigned int x, unsigned int y)
+{
+  return (x * 37 + y * 11 + k * 53) % 250;
+}
+
+void setup_testMaps(MapSet& maps, Table<uint8_t, xSize, ySize> (&tables)[K])
+{
+  maps.initialise();
+  for (unsigned int x = 0; x < xSize; x++) { maps.setXAxisValueByIndex(x, xAxis[x]); }
+  for (unsigned int y = 0; y < ySize; y++) { maps.setYAxisValueByIndex(y, yAxis[y]); }
+  for (unsigned int k = 0; k < K; k++) {
+    tables[k].initialise();
+    for (unsigned int x = 0; x < xSize; x++) { tables[k].setXAxisValueByIndex(x, xAxis[x]); }
+    for (unsigned int y = 0; y < ySize; y++) { tables[k].setYAxisValueByIndex(y, yAxis[y]); }
+    for (unsigned int x = 0; x < xSize; x++) {
+      for (unsigned int y = 0; y < ySize; y++) {
+        maps.setValueByIndex(k, x, y, planeValue(k, x, y));
+        tables[k].setValueByIndex(x, y, planeValue(k, x, y));
+      }
+    }
+  }
+}
+
+void run_tests()
+{
+  UNITY_BEGIN(); // IMPORTANT LINE!
+  RUN_TEST(test_matchesTables);
+  RUN_TEST(test_constLookup);
+  RUN_TEST(test_singleAxis);
+  RUN_TEST(test_outOfBounds);
+  RUN_TEST(test_setters);
+  RUN_TEST(test_bulkSetters);
+  UNITY_END(); // stop unit testing
+}
+
+void test_matchesTables(void)
+{
+  MapSet maps;
+  Table<uint8_t, xSize, ySize> tables[K];
+  setup_testMaps(maps, tables);
+
+  double out[K];
+  for (int x = 500; x <= 7000; x += 45) {
+    for (int y = 20; y <= 100; y += 3) {
+      TEST_ASSERT_TRUE(maps.getValues(x, y, out));
+      for (unsigned int k = 0; k < K; k++) {
+        TEST_ASSERT_DOUBLE_WITHIN(1e-9, tables[k].getValue(x, y), out[k]);
+      }
+    }
+  }
+  // Breakpoints are exact
+  maps.getValues(2000, 60, out);
+  for (unsigned int k = 0; k < K; k++) { TEST_ASSERT_EQUAL_DOUBLE(planeValue(k, 2, 2), out[k]); }
+  TEST_ASSERT_EQUAL_DOUBLE(planeValue(3, 5, 4), maps.getValue(3, 7000, 100));
+}
+
+void test_constLookup(void)
+{
+  MapSet maps;
+  Table<uint8_t, xSize, ySize> tables[K];
+  setup_testMaps(maps, tables);
+  const MapSet& constMaps = maps;
+
+  double out[K];
+  TEST_ASSERT_TRUE(constMaps.getValues(1234, 55, out));
+  for (unsigned int k = 0; k < K; k++) {
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, tables[k].getValue(1234, 55), out[k]);
+  }
+}
+
+void test_singleAxis(void)
+{
+  TableSet<int16_t, 2, 3> curves;
+  curves.initialise();
+  curves.setXAxisValueByIndex(0, 0);
+  curves.setXAxisValueByIndex(1, 10);
+  curves.setXAxisValueByIndex(2, 30);
+  for (unsigned int x = 0; x < 3; x++) {
+    curves.setValueByIndex(0, x, 0, x * 100);
+    curves.setValueByIndex(1, x, 0, -static_cast<int>(x) * 10);
+  }
+  double out[2];
+  TEST_ASSERT_TRUE(curves.getValues(20, out));
+  TEST_ASSERT_EQUAL_DOUBLE(150, out[0]);
+  TEST_ASSERT_EQUAL_DOUBLE(-15, out[1]);
+  TEST_ASSERT_EQUAL_DOUBLE(50, curves.getValue(0, 5, 1));
+}
+
+void test_outOfBounds(void)
+{
+  MapSet maps;
+  Table<uint8_t, xSize, ySize> tables[K];
+  setup_testMaps(maps, tables);
+
+  double out[K];
+  TEST_ASSERT_FALSE(maps.getValues(400, 50, out));
+  for (unsigned int k = 0; k < K; k++) { TEST_ASSERT_EQUAL_DOUBLE(-1, out[k]); }
+  TEST_ASSERT_FALSE(maps.getValues(1000, 101, out));
+  TEST_ASSERT_EQUAL_DOUBLE(-1, maps.getValue(0, 7001, 50));
+  TEST_ASSERT_EQUAL_DOUBLE(-1, maps.getValue(K, 1000, 50));
+  TEST_ASSERT_EQUAL_DOUBLE(-1, maps.getValue(K + 100, 1000, 50));
+}
+
+void test_setters(void)
+{
+  MapSet maps;
+  maps.initialise();
+  TEST_ASSERT_FALSE(maps.setValueByIndex(K, 0, 0, 1));
+  TEST_ASSERT_FALSE(maps.setValueByIndex(0, xSize, 0, 1));
+  TEST_ASSERT_FALSE(maps.setValueByIndex(0, 0, ySize, 1));
+  TEST_ASSERT_FALSE(maps.setXAxisValueByIndex(xSize, 1));
+  TEST_ASSERT_FALSE(maps.setYAxisValueByIndex(ySize, 1));
+  TEST_ASSERT_TRUE(maps.setValueByIndex(2, 1, 3, 99));
+  TEST_ASSERT_EQUAL(99, maps.getValueByIndex(2, 1, 3));
+  TEST_ASSERT_EQUAL(0, maps.getValueByIndex(1, 1, 3));
+  TEST_ASSERT_TRUE(maps.setXAxisValueByIndex(4, 1234));
+  TEST_ASSERT_EQUAL(1234, maps.getXAxisValueByIndex(4));
+  TEST_ASSERT_TRUE(maps.setYAxisValueByIndex(2, 77));
+  TEST_ASSERT_EQUAL(77, maps.getYAxisValueByIndex(2));
+
+  maps.resetData();
+  TEST_ASSERT_EQUAL(0, maps.getValueByIndex(2, 1, 3));
+  TEST_ASSERT_EQUAL(0, maps.getXAxisValueByIndex(4));
+}
+
+void test_bulkSetters(void)
+{
+  MapSet maps;
+  Table<uint8_t, xSize, ySize> tables[K];
+  setup_testMaps(maps, tables);
+  MapSet bulk;
+  bulk.initialise();
+  TEST_ASSERT_TRUE(bulk.setXAxis(xAxis, xSize));
+  TEST_ASSERT_TRUE(bulk.setYAxis(yAxis, ySize));
+  for (unsigned int k = 0; k < K; k++) {
+    uint8_t plane[xSize * ySize];
+    for (unsigned int x = 0; x < xSize; x++) {
+      for (unsigned int y = 0; y < ySize; y++) { plane[x * ySize + y] = planeValue(k, x, y); }
+    }
+    TEST_ASSERT_TRUE(bulk.setPlane(k, plane, xSize * ySize));
+  }
+  double expected[K];
+  double out[K];
+  maps.getValues(2700, 33, expected);
+  bulk.getValues(2700, 33, out);
+  for (unsigned int k = 0; k < K; k++) { TEST_ASSERT_EQUAL_DOUBLE(expected[k], out[k]); }
+
+  constexpr int unsorted[ySize] = {20, 40, 30, 80, 100};
+  uint8_t plane[xSize * ySize] = {0};
+  TEST_ASSERT_FALSE(bulk.setYAxis(unsorted, ySize));
+  TEST_ASSERT_FALSE(bulk.setXAxis(xAxis, xSize - 1));
+  TEST_ASSERT_FALSE(bulk.setPlane(K, plane, xSize * ySize));
+  TEST_ASSERT_FALSE(bulk.setPlane(0, plane, xSize));
+  TEST_ASSERT_EQUAL(40, bulk.getYAxisValueByIndex(1));
+}
+
+void setUp (void) {}
+
+void tearDown (void) {}
+
+int main(int argc, char **argv) {
+  run_tests();
+  return 0;
+}
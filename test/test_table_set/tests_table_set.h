@@ -0,0 +1,14 @@
+#include <unity.h>
+#include <cstdio>
+
+void run_tests();
+void test_matchesTables(void);
+void test_constLookup(void);
+void test_singleAxis(void);
+void test_outOfBounds(void);
+void test_setters(void);
+void test_bulkSetters(void);
+
+constexpr unsigned int K = 4;
+constexpr unsigned int xSize = 6;
+constexpr unsigned int ySize = 5;
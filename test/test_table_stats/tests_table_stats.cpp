@@ -0,0 +1,174 @@
+#include "tests_table_stats.h"
+
+#include "Table.h"
+
+/**
+ * A cycle counter which advances 10 cycles every time it is read.
+ */
+struct FakeCycleCounter {
+  typedef unsigned long Ticks;
+  static Ticks now() { return ticks += 10; }
+  static Ticks ticks;
+};
+FakeCycleCounter::Ticks FakeCycleCounter::ticks = 0;
+
+typedef Table<uint8_t, xSize, ySize, int, int, double, TableRowMajor, 1, TableCountingStats<FakeCycleCounter>> StatsTable;
+
+// Instrumentation is zero cost when disabled
+static_assert(sizeof(Table<uint8_t, xSize, ySize>) == sizeof(Table<uint8_t, xSize, ySize, int, int, double, TableRowMajor, 1, TableNoStats>),
+              "TableNoStats must not add to the size of a Table");
+constexpr Table<uint8_t, 2, 2> romMap({0, 10}, {0, 10}, {0, 10, 20, 30});
+
+void setup_testMap(StatsTable& map)
+{
+  /*
+  40  |   20 |   25 |   60 |   65
+  30  |   15 |   30 |   55 |   70
+  20  |   10 |   35 |   50 |   75
+  10  |    5 |   40 |   45 |   80
+      ----------------------------
+          10 |   20 |   30 |   40
+  */
+  constexpr uint8_t rows[ySize][xSize] = {{5, 40, 45, 80}, {10, 35, 50, 75}, {15, 30, 55, 70}, {20, 25, 60, 65}};
+  map.initialise();
+  for (unsigned int x = 0; x < xSize; x++) { map.setXAxisValueByIndex(x, 10 + x * 10); }
+  for (unsigned int y = 0; y < ySize; y++) { map.setYAxisValueByIndex(y, 10 + y * 10); }
+  for (unsigned int x = 0; x < xSize; x++) {
+    for (unsigned int y = 0; y < ySize; y++) { map.setValueByIndex(x, y, rows[y][x]); }
+  }
+  map.resetStats();
+}
+
+void run_tests()
+{
+  UNITY_BEGIN(); // IMPORTANT LINE!
+  RUN_TEST(test_noStats);
+  RUN_TEST(test_paths);
+  RUN_TEST(test_cacheHits);
+  RUN_TEST(test_searchSteps);
+  RUN_TEST(test_cycles);
+  RUN_TEST(test_reset);
+  UNITY_END(); // stop unit testing
+}
+
+void test_noStats(void)
+{
+  TEST_ASSERT_EQUAL(15, romMap.getValue(5, 5));
+  TableStatsSnapshot stats = romMap.getStats();
+  TEST_ASSERT_EQUAL(0, stats.calls);
+  TEST_ASSERT_EQUAL(0, stats.totalCycles);
+}
+
+void test_paths(void)
+{
+  StatsTable map;
+  setup_testMap(map);
+
+  TEST_ASSERT_EQUAL(40, map.getValue(20, 10));     // exact
+  TEST_ASSERT_EQUAL(22.5, map.getValue(15, 15));   // bilinear
+  TEST_ASSERT_EQUAL(-1, map.getValue(5, 15));      // out of bounds
+  TEST_ASSERT_EQUAL(-1, map.getValue(15, 45));     // out of bounds
+
+  // The const lookups are counted too
+  const StatsTable& constMap = map;
+  TEST_ASSERT_EQUAL(22.5, constMap.getValue(15, 15));
+
+  TableStatsSnapshot stats = map.getStats();
+  TEST_ASSERT_EQUAL(5, stats.calls);
+  TEST_ASSERT_EQUAL(1, stats.exactHits);
+  TEST_ASSERT_EQUAL(2, stats.bilinear);
+  TEST_ASSERT_EQUAL(0, stats.linear);
+  TEST_ASSERT_EQUAL(2, stats.outOfBounds);
+  TEST_ASSERT_EQUAL(0, stats.resultCacheHits);
+
+  // A (x, 1) sized table interpolates along x only
+  Table<uint8_t, 3, 1, int, int, double, TableRowMajor, 1, TableCountingStats<FakeCycleCounter>> map2d;
+  map2d.initialise();
+  for (unsigned int x = 0; x < 3; x++) {
+    map2d.setXAxisValueByIndex(x, x * 10);
+    map2d.setValueByIndex(x, x * 20);
+  }
+  TEST_ASSERT_EQUAL(30, map2d.getValue(15));
+  TEST_ASSERT_EQUAL(20, map2d.getValue(10));
+  TEST_ASSERT_EQUAL(1, map2d.getStats().linear);
+  TEST_ASSERT_EQUAL(1, map2d.getStats().exactHits);
+  TEST_ASSERT_EQUAL(0, map2d.getStats().bilinear);
+}
+
+void test_cacheHits(void)
+{
+  StatsTable map;
+  setup_testMap(map);
+  for (int i = 0; i < 5; i++) { TEST_ASSERT_EQUAL(22.5, map.getValue(15, 15)); }
+  TableStatsSnapshot stats = map.getStats();
+  TEST_ASSERT_EQUAL(5, stats.calls);
+  TEST_ASSERT_EQUAL(4, stats.resultCacheHits);
+  TEST_ASSERT_EQUAL(1, stats.bilinear);
+}
+
+void test_searchSteps(void)
+{
+  StatsTable map;
+  setup_testMap(map);
+
+  // Uniform axes are indexed directly, one probe per axis
+  map.getValue(15, 15);
+  TEST_ASSERT_EQUAL(2, map.getStats().searchSteps);
+
+  // Uneven axes are searched, 1 probe when the cell is at or next to the previous one
+  map.setXAxisValueByIndex(0, 0);
+  map.setYAxisValueByIndex(0, 0);
+  map.resetStats();
+  map.getValue(15, 15);
+  TEST_ASSERT_EQUAL(2, map.getStats().searchSteps);
+  map.getValue(35, 35);
+  TEST_ASSERT_EQUAL(2 + 2 * (1 + 2), map.getStats().searchSteps);
+}
+
+void test_cycles(void)
+{
+  StatsTable map;
+  setup_testMap(map);
+  map.getValue(15, 15);
+  map.getValue(5, 15);
+  map.getValue(25, 25);
+  TableStatsSnapshot stats = map.getStats();
+  TEST_ASSERT_EQUAL(3, stats.calls);
+  TEST_ASSERT_EQUAL(10, stats.minCycles);
+  TEST_ASSERT_EQUAL(10, stats.maxCycles);
+  TEST_ASSERT_EQUAL(30, stats.totalCycles);
+
+  // A real counter measures something
+  Table<uint8_t, xSize, ySize, int, int, double, TableRowMajor, 1, TableCountingStats<>> timed;
+  timed.initialise();
+  for (unsigned int x = 0; x < xSize; x++) { timed.setXAxisValueByIndex(x, x * 10); }
+  for (unsigned int y = 0; y < ySize; y++) { timed.setYAxisValueByIndex(y, y * 10); }
+  for (int i = 0; i < 100; i++) { timed.getValue(i % 30, (i * 7) % 30); }
+  stats = timed.getStats();
+  TEST_ASSERT_EQUAL(100, stats.calls);
+  TEST_ASSERT_TRUE(stats.minCycles <= stats.maxCycles);
+  TEST_ASSERT_TRUE(stats.totalCycles >= stats.maxCycles);
+}
+
+void test_reset(void)
+{
+  StatsTable map;
+  setup_testMap(map);
+  map.getValue(15, 15);
+  map.resetStats();
+  TableStatsSnapshot stats = map.getStats();
+  TEST_ASSERT_EQUAL(0, stats.calls);
+  TEST_ASSERT_EQUAL(0, stats.bilinear);
+  TEST_ASSERT_EQUAL(0, stats.maxCycles);
+  map.getValue(25, 25);
+  TEST_ASSERT_EQUAL(10, map.getStats().minCycles);
+}
+
+void setUp (void) {}
+
+void tearDown (void) {}
+
+int main(int argc, char **argv) {
+  run_tests();
+  return 0;
+}
@@ -0,0 +1,13 @@
+#include <unity.h>
+#include <cstdio>
+
+void run_tests();
+void test_noStats(void);
+void test_paths(void);
+void test_cacheHits(void);
+void test_searchSteps(void);
+void test_cycles(void);
+void test_reset(void);
+
+constexpr unsigned int xSize = 4;
+constexpr unsigned int ySize = 4;
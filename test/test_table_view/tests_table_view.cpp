@@ -0,0 +1,160 @@
+#include "tests_table_view.h"
+
+#include "TableView.h"
+
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+Table<uint16_t, xSize, ySize> testMap;
+alignas(8) char testImage[Table<uint16_t, xSize, ySize>::getSize()];
+
+void setup_testMap(void)
+{
+  //Table is setup per the below, then saved to testImage
+  /*
+  40  |   20 |   25 |  600 |   65
+  30  |   15 |   30 |  550 |   70
+  20  |   10 |   35 |  500 |   75
+  10  |    5 |   40 |  450 |  800
+      ----------------------------
+          10 |   20 |   35 |   40
+  */
+  testMap.initialise();
+
+  constexpr int tempXAxis[xSize] = {10, 20, 35, 40};
+  for (unsigned int x = 0; x < xSize; x++) { testMap.setXAxisValueByIndex(x, tempXAxis[x]); }
+  constexpr int tempYAxis[ySize] = {10, 20, 30, 40};
+  for (unsigned int y = 0; y < ySize; y++) { testMap.setYAxisValueByIndex(y, tempYAxis[y]); }
+
+  for (unsigned int x = 0; x < xSize; x++) { testMap.setValueByIndex(x, 0, tempRow1[x]); }
+  for (unsigned int x = 0; x < xSize; x++) { testMap.setValueByIndex(x, 1, tempRow2[x]); }
+  for (unsigned int x = 0; x < xSize; x++) { testMap.setValueByIndex(x, 2, tempRow3[x]); }
+  for (unsigned int x = 0; x < xSize; x++) { testMap.setValueByIndex(x, 3, tempRow4[x]); }
+
+  testMap.saveData(testImage, sizeof(testImage));
+}
+
+void run_tests()
+{
+  UNITY_BEGIN(); // IMPORTANT LINE!
+  RUN_TEST(test_viewLookup);
+  RUN_TEST(test_viewInvalid);
+  RUN_TEST(test_viewUnboundIndex);
+  RUN_TEST(test_viewMisaligned);
+  RUN_TEST(test_viewMmap);
+  UNITY_END(); // stop unit testing
+}
+
+void check_view(const TableView<uint16_t, xSize, ySize>& view)
+{
+  TEST_ASSERT_TRUE(view.isValid());
+  TEST_ASSERT_EQUAL(35, view.getValueByIndex(1, 1));
+  TEST_ASSERT_EQUAL(800, view.getValueByIndex(3, 0));
+  for (int x = 8; x <= 42; x++) {
+    for (int y = 8; y <= 42; y += 3) {
+      TEST_ASSERT_FLOAT_WITHIN(0.0001, testMap.getValue(x, y), view.getValue(x, y));
+    }
+  }
+}
+
+void test_viewLookup(void)
+{
+  setup_testMap();
+
+  TableView<uint16_t, xSize, ySize> view(testImage, sizeof(testImage));
+  check_view(view);
+
+  // Lookups read the image in place
+  testMap.setValueByIndex(1, 1, 1234);
+  testMap.saveData(testImage, sizeof(testImage));
+  TEST_ASSERT_EQUAL(1234, view.getValueByIndex(1, 1));
+  TEST_ASSERT_EQUAL(1234, view.getValue(20, 20));
+}
+
+void test_viewInvalid(void)
+{
+  setup_testMap();
+
+  // Unbound
+  TableView<uint16_t, xSize, ySize> view;
+  TEST_ASSERT_FALSE(view.isValid());
+  TEST_ASSERT_EQUAL(-1, view.getValue(20, 20));
+
+  // Corrupt image
+  testImage[40] ^= 1;
+  TEST_ASSERT_FALSE(view.bind(testImage, sizeof(testImage)));
+  TEST_ASSERT_EQUAL(-1, view.getValue(20, 20));
+  testImage[40] ^= 1;
+  TEST_ASSERT_TRUE(view.bind(testImage, sizeof(testImage)));
+
+  // Wrong size and wrong type
+  TEST_ASSERT_FALSE(view.bind(testImage, sizeof(testImage) - 1));
+  TableView<int16_t, xSize, ySize> otherType;
+  TEST_ASSERT_FALSE(otherType.bind(testImage, sizeof(testImage)));
+}
+
+void test_viewUnboundIndex(void)
+{
+  setup_testMap();
+
+  // An unbound view has no values to read
+  TableView<uint16_t, xSize, ySize> view;
+  TEST_ASSERT_EQUAL(0, view.getValueByIndex(1, 2));
+  TEST_ASSERT_EQUAL(0, view.getValueByIndex(3));
+
+  // A failed bind leaves the view unbound
+  TEST_ASSERT_FALSE(view.bind(testImage, sizeof(testImage) - 1));
+  TEST_ASSERT_EQUAL(0, view.getValueByIndex(1, 2));
+
+  TEST_ASSERT_TRUE(view.bind(testImage, sizeof(testImage)));
+  TEST_ASSERT_EQUAL(testMap.getValueByIndex(1, 2), view.getValueByIndex(1, 2));
+}
+
+void test_viewMisaligned(void)
+{
+  setup_testMap();
+
+  // The image must be aligned for the axis type
+  alignas(8) char buffer[sizeof(testImage) + 1];
+  memcpy(buffer + 1, testImage, sizeof(testImage));
+  TableView<uint16_t, xSize, ySize> view;
+  TEST_ASSERT_FALSE(view.bind(buffer + 1, sizeof(testImage)));
+}
+
+void test_viewMmap(void)
+{
+#if defined(__unix__) || defined(__APPLE__)
+  setup_testMap();
+
+  char path[] = "/tmp/table_view_XXXXXX";
+  int fd = mkstemp(path);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL(sizeof(testImage), write(fd, testImage, sizeof(testImage)));
+
+  void* mapped = mmap(nullptr, sizeof(testImage), PROT_READ, MAP_SHARED, fd, 0);
+  TEST_ASSERT_TRUE(mapped != MAP_FAILED);
+
+  TableView<uint16_t, xSize, ySize> view(mapped, sizeof(testImage));
+  check_view(view);
+
+  munmap(mapped, sizeof(testImage));
+  close(fd);
+  unlink(path);
+#else
+  TEST_MESSAGE("mmap is not available on this platform");
+#endif
+}
+
+void setUp (void) {}
+
+void tearDown (void) {}
+
+int main(int argc, char **argv) {
+  run_tests();
+  return 0;
+}
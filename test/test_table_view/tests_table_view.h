@@ -0,0 +1,18 @@
+#include <unity.h>
+#include <cstdio>
+
+void run_tests();
+void setup_testMap(void);
+void test_viewLookup(void);
+void test_viewInvalid(void);
+void test_viewUnboundIndex(void);
+void test_viewMisaligned(void);
+void test_viewMmap(void);
+
+constexpr unsigned int xSize = 4;
+constexpr unsigned int ySize = 4;
+
+constexpr uint16_t tempRow4[xSize] = {20, 25, 600, 65};
+constexpr uint16_t tempRow3[xSize] = {15, 30, 550, 70};
+constexpr uint16_t tempRow2[xSize] = {10, 35, 500, 75};
+constexpr uint16_t tempRow1[xSize] = {5, 40, 450, 800};